@@ -4,4 +4,6 @@
 #include <cot/logging.h>
 #include <cot/effects.h>
 #include <cot/custom_instructions.h>
+#include <cot/special_processes.h>
+#include <cot/profile.h>
 #include <cot/menus.h>
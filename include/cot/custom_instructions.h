@@ -6,8 +6,15 @@
 // Set this value to 1 to enable support for custom script engine instructions
 #define CUSTOM_GROUND_INSTRUCTIONS 0
 
+// Decides what happens to a custom instruction when a skipped cutscene is scanned by CRASS.
+enum custom_instruction_skip_kind {
+  CUSTOM_INSTRUCTION_SKIP_STEP_OVER = 0, // The instruction is skipped over without running. Suited for visual-only instructions.
+  CUSTOM_INSTRUCTION_SKIP_EXECUTE = 1, // The instruction is run, e.g. because it sets variables or returns a value checked by a switch-statement.
+};
+
 struct custom_instruction {
   int8_t n_params;
+  uint8_t skip_kind; // See "custom_instruction_skip_kind". A single byte so the struct stays 12 bytes large, which HookGetParameterCount relies on.
   void (*handler)(struct script_routine* routine, uint16_t* args);
   char *name;
 };
@@ -15,3 +22,4 @@ struct custom_instruction {
 void DispatchCustomInstruction(int index, struct script_routine* routine, uint16_t* args);
 extern struct custom_instruction CUSTOM_INSTRUCTIONS[];
 extern const int CUSTOM_INSTRUCTION_AMOUNT;
+extern const int FIRST_CUSTOM_OPCODE;
@@ -6,6 +6,18 @@ typedef struct move_effect_input {
   bool out_dealt_damage;
 } move_effect_input;
 
+// Moves and items with a custom effect, generated from src/custom_effects.yml.
+// A handler should return true if a custom effect was applied.
+struct custom_move_effect {
+  uint16_t id;
+  bool (*handler)(move_effect_input* data, struct entity* user, struct entity* target, struct move* move);
+};
+
+struct custom_item_effect {
+  uint16_t id;
+  bool (*handler)(struct entity* user, struct entity* target, struct item* item, bool is_thrown);
+};
+
 // Custom effects handling functions.
 bool CustomApplyItemEffect(struct entity* user, struct entity* target, struct item* item, bool is_thrown);
 bool CustomApplyMoveEffect(move_effect_input* data, struct entity* user, struct entity* target, struct move* move);
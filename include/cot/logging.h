@@ -1,10 +1,62 @@
 #pragma once
 
-#define COT_LOG_CAT_DEFAULT "cot"
-#define COT_LOG_CAT_SPECIAL_PROCESS "cot.special_process"
-#define COT_LOG_CAT_EFFECTS "cot.effects"
-#define COT_LOG_CAT_INSTRUCTIONS "cot.ground_instructions"
-#define COT_LOG_CAT_MENUS "cot.script_menus"
+#define COT_LOG_LEVEL_LOG 0
+#define COT_LOG_LEVEL_WARN 1
+#define COT_LOG_LEVEL_ERROR 2
+#define COT_LOG_LEVEL_NONE 3
+
+// Minimum level of the logs kept in each category. Logs below it are removed at compile time.
+// Each level can be overridden in the Makefile, see LOG_LEVELS.
+#ifndef COT_LOG_LEVEL_DEFAULT
+#define COT_LOG_LEVEL_DEFAULT COT_LOG_LEVEL_LOG
+#endif
+#ifndef COT_LOG_LEVEL_SPECIAL_PROCESS
+#define COT_LOG_LEVEL_SPECIAL_PROCESS COT_LOG_LEVEL_DEFAULT
+#endif
+#ifndef COT_LOG_LEVEL_EFFECTS
+#define COT_LOG_LEVEL_EFFECTS COT_LOG_LEVEL_DEFAULT
+#endif
+#ifndef COT_LOG_LEVEL_INSTRUCTIONS
+#define COT_LOG_LEVEL_INSTRUCTIONS COT_LOG_LEVEL_DEFAULT
+#endif
+#ifndef COT_LOG_LEVEL_MENUS
+#define COT_LOG_LEVEL_MENUS COT_LOG_LEVEL_DEFAULT
+#endif
+#ifndef COT_LOG_LEVEL_CRASS
+#define COT_LOG_LEVEL_CRASS COT_LOG_LEVEL_DEFAULT
+#endif
+#ifndef COT_LOG_LEVEL_PROFILE
+#define COT_LOG_LEVEL_PROFILE COT_LOG_LEVEL_DEFAULT
+#endif
+
+// A category is its name and its minimum level in parentheses. To add your own, define it the same way:
+// #define MY_LOG_CAT ("my.category", COT_LOG_LEVEL_WARN)
+// A plain string like "my.category" can still be used as a category, and keeps logs down to COT_LOG_LEVEL_DEFAULT.
+#define COT_LOG_CAT_DEFAULT ("cot", COT_LOG_LEVEL_DEFAULT)
+#define COT_LOG_CAT_SPECIAL_PROCESS ("cot.special_process", COT_LOG_LEVEL_SPECIAL_PROCESS)
+#define COT_LOG_CAT_EFFECTS ("cot.effects", COT_LOG_LEVEL_EFFECTS)
+#define COT_LOG_CAT_INSTRUCTIONS ("cot.ground_instructions", COT_LOG_LEVEL_INSTRUCTIONS)
+#define COT_LOG_CAT_MENUS ("cot.script_menus", COT_LOG_LEVEL_MENUS)
+#define COT_LOG_CAT_CRASS ("cot.crass", COT_LOG_LEVEL_CRASS)
+#define COT_LOG_CAT_PROFILE ("cot.profile", COT_LOG_LEVEL_PROFILE)
+
+// Set this value to 1 to store logs in the ring buffer COT_LOG_RING instead of printing them with DebugPrint.
+// Each log then only stores the ID of its format string and its raw arguments, without any formatting on the DS.
+// The format strings aren't patched into the ROM. To read the logs, dump COT_LOG_RING from memory and
+// decode it with scripts/decode_log.py.
+#ifndef COT_BINARY_LOG
+#define COT_BINARY_LOG 0
+#endif
+
+// Number of 32-bit words in COT_LOG_RING, must be a power of two. Each log takes one word, plus one per argument.
+#define COT_LOG_RING_CAPACITY 512
+
+struct cot_log_ring {
+  uint32_t head; // Total number of words ever written, the next word is written at head % COT_LOG_RING_CAPACITY
+  // Each log is stored as its arguments followed by a header word:
+  // the offset of its format string in .cot_log_fmt << 8 | level << 4 | number of arguments
+  uint32_t words[COT_LOG_RING_CAPACITY];
+};
 
 // Needs two macros for some reason
 #define _COT_INTERNAL_STRINGIZE_DETAIL(x) #x
@@ -15,13 +67,63 @@
 #define _COT_INTERNAL_LOG_MESSAGE(category, format) \
   "[" category "] " format " (" __FILE__ ":" _COT_INTERNAL_STRINGIZE(__LINE__) ")"
 
-#define COT_LOG(category, format)           DebugPrint(0, _COT_INTERNAL_LOG_MESSAGE(category, format))
-#define COT_WARN(category, format)          DebugPrint(1, _COT_INTERNAL_LOG_MESSAGE(category, format))
-#define COT_ERROR(category, format)         DebugPrint(2, _COT_INTERNAL_LOG_MESSAGE(category, format))
+#if COT_BINARY_LOG
+
+extern struct cot_log_ring COT_LOG_RING;
+void cotInternalLogBinary(uint32_t header, ...);
+
+// Counts the arguments passed to a log, up to 15
+#define _COT_INTERNAL_NARGS(...) \
+  _COT_INTERNAL_NARGS_DETAIL(0, ##__VA_ARGS__, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define _COT_INTERNAL_NARGS_DETAIL(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, N, ...) N
+
+// The format string is placed in the non-loaded section .cot_log_fmt (see linker.ld), and its address in there is its ID
+#define _COT_INTERNAL_LOG_OUTPUT(level, category, format, ...) { \
+    static const char _cot_log_format[] __attribute__((section(".cot_log_fmt"))) = _COT_INTERNAL_LOG_MESSAGE(category, format); \
+    cotInternalLogBinary(((uint32_t) _cot_log_format << 8) | ((level) << 4) | _COT_INTERNAL_NARGS(__VA_ARGS__), ##__VA_ARGS__); \
+  }
+
+#else
+
+#define _COT_INTERNAL_LOG_OUTPUT(level, category, format, ...) \
+  DebugPrint(level, _COT_INTERNAL_LOG_MESSAGE(category, format), ##__VA_ARGS__);
+
+#endif
+
+#define _COT_INTERNAL_CONCAT(a, b) _COT_INTERNAL_CONCAT_DETAIL(a, b)
+#define _COT_INTERNAL_CONCAT_DETAIL(a, b) a##b
+
+// Expands to 1 if `category` is a ("name", min_level) pair, or 0 if it's a plain string
+#define _COT_INTERNAL_CAT_IS_PAIR(category) _COT_INTERNAL_CAT_IS_PAIR_DETAIL(_COT_INTERNAL_CAT_PROBE category, 0, ~)
+#define _COT_INTERNAL_CAT_IS_PAIR_DETAIL(...) _COT_INTERNAL_CAT_SECOND(__VA_ARGS__)
+#define _COT_INTERNAL_CAT_PROBE(...) ~, 1
+#define _COT_INTERNAL_CAT_SECOND(a, b, ...) b
+
+#define _COT_INTERNAL_CAT_NAME(category) \
+  _COT_INTERNAL_CONCAT(_COT_INTERNAL_CAT_NAME_, _COT_INTERNAL_CAT_IS_PAIR(category))(category)
+#define _COT_INTERNAL_CAT_NAME_0(category) category
+#define _COT_INTERNAL_CAT_NAME_1(category) _COT_INTERNAL_CAT_PAIR_NAME category
+#define _COT_INTERNAL_CAT_PAIR_NAME(name, min_level) name
+
+#define _COT_INTERNAL_CAT_LEVEL(category) \
+  _COT_INTERNAL_CONCAT(_COT_INTERNAL_CAT_LEVEL_, _COT_INTERNAL_CAT_IS_PAIR(category))(category)
+#define _COT_INTERNAL_CAT_LEVEL_0(category) COT_LOG_LEVEL_DEFAULT
+#define _COT_INTERNAL_CAT_LEVEL_1(category) _COT_INTERNAL_CAT_PAIR_LEVEL category
+#define _COT_INTERNAL_CAT_PAIR_LEVEL(name, min_level) min_level
+
+// The condition is constant, so logs below the minimum level of their category are compiled out.
+#define _COT_INTERNAL_LOG(level, category, format, ...) do { \
+    if ((level) >= _COT_INTERNAL_CAT_LEVEL(category)) \
+      _COT_INTERNAL_LOG_OUTPUT(level, _COT_INTERNAL_CAT_NAME(category), format, ##__VA_ARGS__) \
+  } while (0)
+
+#define COT_LOG(category, format)           _COT_INTERNAL_LOG(COT_LOG_LEVEL_LOG, category, format)
+#define COT_WARN(category, format)          _COT_INTERNAL_LOG(COT_LOG_LEVEL_WARN, category, format)
+#define COT_ERROR(category, format)         _COT_INTERNAL_LOG(COT_LOG_LEVEL_ERROR, category, format)
 
-#define COT_LOGFMT(category, format, ...)   DebugPrint(0, _COT_INTERNAL_LOG_MESSAGE(category, format), __VA_ARGS__)
-#define COT_WARNFMT(category, format, ...)  DebugPrint(1, _COT_INTERNAL_LOG_MESSAGE(category, format), __VA_ARGS__)
-#define COT_ERRORFMT(category, format, ...) DebugPrint(2, _COT_INTERNAL_LOG_MESSAGE(category, format), __VA_ARGS__)
+#define COT_LOGFMT(category, format, ...)   _COT_INTERNAL_LOG(COT_LOG_LEVEL_LOG, category, format, __VA_ARGS__)
+#define COT_WARNFMT(category, format, ...)  _COT_INTERNAL_LOG(COT_LOG_LEVEL_WARN, category, format, __VA_ARGS__)
+#define COT_ERRORFMT(category, format, ...) _COT_INTERNAL_LOG(COT_LOG_LEVEL_ERROR, category, format, __VA_ARGS__)
 
 #define COT_ASSERT(expr) \
   if (!(expr)) {\
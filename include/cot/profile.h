@@ -0,0 +1,82 @@
+#pragma once
+
+#include "basedefs.h"
+#include <pmdsky.h>
+
+// Set this value to 1 to measure how many cycles each hook below takes, using the ARM9 hardware timers 2 and 3.
+// The results are collected in COT_PROFILE_TABLE and printed by CotDumpProfile (special process 252).
+// Like logging, profiling is always disabled in release builds (see RELEASE_CONFIG in the Makefile).
+#ifndef COT_PROFILE
+#define COT_PROFILE 0
+#endif
+
+// The hooks that can be profiled, each with its own entry in COT_PROFILE_TABLE
+enum cot_profile_id {
+  COT_PROFILE_SHOULD_SKIP_CUTSCENE = 0,
+  COT_PROFILE_TRY_CUTSCENE_SKIP_SCAN = 1,
+  COT_PROFILE_CUSTOM_INSTRUCTION = 2,
+  COT_PROFILE_CUSTOM_SCRIPT_MENU = 3,
+  COT_PROFILE_MOVE_EFFECT = 4,
+  COT_PROFILE_ITEM_EFFECT = 5,
+  COT_PROFILE_SPECIAL_PROCESS = 6,
+  COT_PROFILE_AMOUNT
+};
+
+// Cycles are ARM9 cycles, two per tick of the timers running at the 33 MHz bus clock
+struct cot_profile_entry {
+  uint32_t calls;
+  uint32_t min_cycles;
+  uint32_t max_cycles;
+  uint64_t total_cycles;
+};
+
+#if COT_PROFILE && !defined(NDEBUG)
+
+// Timers 2 and 3 are cascaded into a single 32-bit counter
+#define COT_PROFILE_TM2CNT_L (*(volatile uint16_t*) 0x4000108)
+#define COT_PROFILE_TM2CNT_H (*(volatile uint16_t*) 0x400010A)
+#define COT_PROFILE_TM3CNT_L (*(volatile uint16_t*) 0x400010C)
+#define COT_PROFILE_TM3CNT_H (*(volatile uint16_t*) 0x400010E)
+#define COT_PROFILE_TIMER_ENABLE (1 << 7)
+#define COT_PROFILE_TIMER_COUNT_UP (1 << 2)
+
+extern struct cot_profile_entry COT_PROFILE_TABLE[COT_PROFILE_AMOUNT];
+void cotInternalStartProfileTimer(void);
+void cotInternalProfileRecord(enum cot_profile_id id, uint32_t start);
+void CotDumpProfile(bool reset);
+
+static inline uint32_t cotInternalProfileTimer(void) {
+  if (!(COT_PROFILE_TM3CNT_H & COT_PROFILE_TIMER_ENABLE))
+    cotInternalStartProfileTimer();
+  // Read the high half again in case the low half overflowed in between
+  uint16_t high, low;
+  do {
+    high = COT_PROFILE_TM3CNT_L;
+    low = COT_PROFILE_TM2CNT_L;
+  } while (high != COT_PROFILE_TM3CNT_L);
+  return ((uint32_t) high << 16) | low;
+}
+
+struct cot_profile_scope {
+  enum cot_profile_id id;
+  uint32_t start;
+};
+
+static inline void cotInternalProfileScopeEnd(struct cot_profile_scope* scope) {
+  cotInternalProfileRecord(scope->id, scope->start);
+}
+
+// Measures the code between COT_PROFILE_BEGIN(id) and COT_PROFILE_END(id) in the same block
+#define COT_PROFILE_BEGIN(id) uint32_t _cot_profile_start_##id = cotInternalProfileTimer()
+#define COT_PROFILE_END(id) cotInternalProfileRecord(id, _cot_profile_start_##id)
+// Measures the rest of the enclosing block, up to any return statement
+#define COT_PROFILE_SCOPE(id) \
+  struct cot_profile_scope _cot_profile_scope __attribute__((cleanup(cotInternalProfileScopeEnd))) = { id, cotInternalProfileTimer() }
+
+#else
+
+#define COT_PROFILE_BEGIN(id)
+#define COT_PROFILE_END(id)
+#define COT_PROFILE_SCOPE(id)
+
+#endif
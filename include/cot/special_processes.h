@@ -0,0 +1,28 @@
+#pragma once
+
+#include "basedefs.h"
+#include <pmdsky.h>
+
+// Special process IDs below this one are left to the base game and existing patches
+#define FIRST_CUSTOM_SPECIAL_PROCESS 100
+// Custom special processes must use an ID below this one, so they can be looked up in a small table
+#define CUSTOM_SPECIAL_PROCESS_ID_LIMIT 256
+
+// Decides what happens to a custom special process when a skipped cutscene is scanned by CRASS.
+enum custom_special_process_skip_kind {
+  CUSTOM_SPECIAL_PROCESS_SKIP_EXECUTE = 0, // The special process is run, e.g. because it sets variables or returns a value checked by a switch-statement.
+  CUSTOM_SPECIAL_PROCESS_SKIP_STEP_OVER = 1, // The special process is skipped over without running and returns 0. Suited for loading or visual effects.
+  CUSTOM_SPECIAL_PROCESS_SKIP_SIMULATE = 2, // `simulate` is run instead, e.g. to apply the effects of the special process without its visuals.
+};
+
+struct custom_special_process {
+  uint8_t id;
+  uint8_t skip_kind; // See "custom_special_process_skip_kind"
+  int (*handler)(short arg1, short arg2);
+  int (*simulate)(short arg1, short arg2); // Only needed for CUSTOM_SPECIAL_PROCESS_SKIP_SIMULATE
+  char *name;
+};
+
+struct custom_special_process* GetCustomSpecialProcess(uint32_t special_process_id);
+extern struct custom_special_process CUSTOM_SPECIAL_PROCESSES[];
+extern const int CUSTOM_SPECIAL_PROCESS_AMOUNT;
@@ -31,8 +31,10 @@
   .endif
 
   .ifdef HookOpcodeCheck
+  .ifndef SpeedupOpcodeCheck ; CRASS checks the opcode first and then jumps to HookOpcodeCheck itself
   .org OpcodeCheck
     b HookOpcodeCheck
+  .endif
   
   .org GetParameterCount
     bl HookGetParameterCount
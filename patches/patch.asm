@@ -74,5 +74,7 @@
         bl ShowScriptEngineStringInDialogueBox
     .org ShowStringInDialogueBoxCallsite3
         bl ShowScriptEngineStringInDialogueBox
+    .org OpcodeCheck ; chains to HookOpcodeCheck for custom instructions
+        b SpeedupOpcodeCheck
     .endif
 .close
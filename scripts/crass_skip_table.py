@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+# Finds every Acting scene in the ROM that contains an exit opcode and writes it into
+# CRASS_SKIP_TABLE in overlay 36, so the device doesn't have to search these scene scripts itself.
+# The rules used here must match AnalyzeScenePlan and GetOpcodeParseType in src/crass.c.
+import struct
+
+from generate_opcode_parse_table import PARSE_KINDS, load_opcode_ids, load_parse_kinds
+
+OVERLAY_GROUND = 11
+OVERLAY_EXTRA = 36
+
+SSB_HEADER_LENGTH = {"EU": 0x12, "NA": 0x0C, "JP": 0x0C}
+SSB_ROUTINE_INFO_LENGTH = 6
+SCRIPT_OPCODE_SIZE = 8 # struct script_opcode
+CUSTOM_INSTRUCTION_SIZE = 12 # struct custom_instruction
+
+TABLE_ENTRY_FORMAT = "<IHxx" # struct crass_skip_table_entry
+
+def scene_hash(name):
+  """Must match HashSceneName in src/crass.c."""
+  hash = 0x811C9DC5
+  for char in name.lower()[:8]:
+    hash = ((hash ^ ord(char)) * 0x01000193) & 0xFFFFFFFF
+  return hash
+
+def read_u16(data, offset):
+  return struct.unpack_from("<H", data, offset)[0]
+
+def read_overlay_bytes(overlay, ram_address, length):
+  offset = ram_address - overlay.ramAddress
+  return overlay.data[offset:offset + length]
+
+def iter_files(folder, prefix=""):
+  for i, name in enumerate(folder.files):
+    yield prefix + name, folder.firstID + i
+  for name, subfolder in folder.folders:
+    yield from iter_files(subfolder, prefix + name + "/")
+
+def load_param_counts(overlays, symbols):
+  """Returns a dict mapping opcode IDs to their number of parameters, for base game opcodes and custom instructions."""
+  ground_overlay = overlays[OVERLAY_GROUND]
+  extra_overlay = overlays[OVERLAY_EXTRA]
+  param_counts = {}
+
+  op_count = len(load_opcode_ids())
+  op_table = read_overlay_bytes(ground_overlay, symbols["SCRIPT_OP_CODES"], op_count * SCRIPT_OPCODE_SIZE)
+  for opcode_id in range(op_count):
+    param_counts[opcode_id] = struct.unpack_from("<b", op_table, opcode_id * SCRIPT_OPCODE_SIZE)[0]
+
+  if "CUSTOM_INSTRUCTIONS" in symbols:
+    first_custom_opcode = struct.unpack("<i", read_overlay_bytes(extra_overlay, symbols["FIRST_CUSTOM_OPCODE"], 4))[0]
+    amount = struct.unpack("<i", read_overlay_bytes(extra_overlay, symbols["CUSTOM_INSTRUCTION_AMOUNT"], 4))[0]
+    instructions = read_overlay_bytes(extra_overlay, symbols["CUSTOM_INSTRUCTIONS"], amount * CUSTOM_INSTRUCTION_SIZE)
+    for index in range(amount):
+      param_counts[first_custom_opcode + index] = struct.unpack_from("<b", instructions, index * CUSTOM_INSTRUCTION_SIZE)[0]
+  return param_counts
+
+def analyze_scene(data, region, param_counts, parse_kinds):
+  """Returns (opcode_length, has_exit_opcode) for the SSB file of an Acting scene."""
+  data_start = SSB_HEADER_LENGTH[region]
+  data_end = data_start + read_u16(data, 0x4) * 2
+  routine_info_start = data_start + read_u16(data, data_start) * 2
+  opcodes_start = routine_info_start + read_u16(data, data_start + 2) * SSB_ROUTINE_INFO_LENGTH
+
+  has_exit_opcode = False
+  offset = opcodes_start
+  while offset < data_end:
+    opcode_id = read_u16(data, offset)
+    if opcode_id not in param_counts:
+      # The parameters can't be counted from here on, so stop like AnalyzeScenePlan does
+      break
+    kind = parse_kinds[opcode_id] if opcode_id < len(parse_kinds) else PARSE_KINDS["manual"]
+    if kind == PARSE_KINDS["dungeon"] or kind == PARSE_KINDS["ground"]:
+      has_exit_opcode = True
+      break
+    n_params = param_counts[opcode_id]
+    offset += ((read_u16(data, offset + 2) & 0x3FFF) + 2 if n_params < 0 else n_params + 1) * 2
+  return (data_end - opcodes_start) // 2, has_exit_opcode
+
+def build_entries(rom, region, param_counts, parse_kinds):
+  """Returns the opcode length of every Acting scene (SSB files with a matching SSA file) with an exit opcode, keyed by scene hash."""
+  paths = dict(iter_files(rom.filenames))
+  entries = {}
+  conflicts = set()
+  for path, file_id in paths.items():
+    if not (path.upper().startswith("SCRIPT/") and path.lower().endswith(".ssb")):
+      continue
+    if path[:-4] + ".ssa" not in paths and path[:-4] + ".SSA" not in paths:
+      continue
+    name = path.split("/")[-1][:-4]
+    key = scene_hash(name)
+    entry = analyze_scene(rom.files[file_id], region, param_counts, parse_kinds)
+    if key in entries and entries[key] != entry:
+      # Scenes with the same name (or hash) in different levels can't be told apart at runtime
+      conflicts.add(key)
+    entries[key] = entry
+  # Scenes that aren't listed are searched on the device, so leaving out conflicts is always safe
+  return {key: entry[0] for key, entry in entries.items() if entry[1] and key not in conflicts}
+
+def apply(rom, overlays, region, symbols, rules_path):
+  if "CRASS_SKIP_TABLE" not in symbols:
+    return
+
+  param_counts = load_param_counts(overlays, symbols)
+  parse_kinds = load_parse_kinds(rules_path, load_opcode_ids())
+  entries = build_entries(rom, region, param_counts, parse_kinds)
+
+  extra_overlay = overlays[OVERLAY_EXTRA]
+  capacity = struct.unpack("<i", read_overlay_bytes(extra_overlay, symbols["CRASS_SKIP_TABLE_MAX_LENGTH"], 4))[0]
+  keys = sorted(entries)
+  if len(keys) > capacity:
+    print(f"Warning: {len(keys)} scenes don't fit into CRASS_SKIP_TABLE (capacity {capacity}), the rest will be searched on the device.")
+    keys = keys[:capacity]
+
+  table = bytearray(struct.pack("<I", len(keys)))
+  for key in keys:
+    table += struct.pack(TABLE_ENTRY_FORMAT, key, entries[key])
+
+  print("Writing CRASS skip table:", len(keys), "scenes")
+  overlay_bytes = bytearray(rom.files[extra_overlay.fileID])
+  offset = symbols["CRASS_SKIP_TABLE"] - extra_overlay.ramAddress
+  overlay_bytes[offset:offset + len(table)] = table
+  rom.files[extra_overlay.fileID] = bytes(overlay_bytes)
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+# Decodes a memory dump of COT_LOG_RING written with COT_BINARY_LOG enabled (see include/cot/logging.h).
+#
+# Usage: decode_log.py <out.elf> <dump.bin> [dump address]
+#
+# The dump either starts at COT_LOG_RING, or at the given address (e.g. 0x2000000 for a dump of main RAM).
+# Format strings are read from the .cot_log_fmt section of the ELF file, which must be the one the ROM was patched with.
+import os
+import re
+import struct
+import sys
+import tempfile
+from subprocess import Popen, PIPE
+
+LEVELS = ["LOG", "WARN", "ERROR"]
+
+# Matches printf conversion specifications, like %d, %08X or %s
+FORMAT_PATTERN = re.compile(r"%[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z|j|t)?([diouxXcsp%])")
+
+def run(args):
+  process = Popen(args, stdout=PIPE)
+  (stdout, stderr) = process.communicate()
+  exit_code = process.wait()
+  assert exit_code == 0, f"{args[0]} failed with code {exit_code}"
+  return stdout.decode()
+
+def load_symbol(elf_path, name):
+  """Returns the address and size of a symbol in the ELF file."""
+  for line in run(["arm-none-eabi-nm", "-S", elf_path]).split('\n'):
+    parts = line.strip().split()
+    if len(parts) == 4 and parts[3] == name:
+      return int(parts[0], 16), int(parts[1], 16)
+  raise ValueError(f"Symbol {name} not found in {elf_path}, was it built with COT_BINARY_LOG enabled?")
+
+def dump_section(elf_path, section):
+  with tempfile.TemporaryDirectory() as tmpdirname:
+    binaryfile = os.path.join(tmpdirname, "section.bin")
+    run(["arm-none-eabi-objcopy", "--dump-section", f"{section}={binaryfile}", elf_path, os.path.join(tmpdirname, "out.elf")])
+    with open(binaryfile, "rb") as f:
+      return f.read()
+
+def load_loaded_sections(elf_path):
+  """Returns a list of (address, bytes) for every section patched into the ROM, used to resolve string arguments."""
+  sections = []
+  for line in run(["arm-none-eabi-objdump", "-h", elf_path]).split('\n'):
+    parts = line.split()
+    # Line: ID, Name, Size, VMA, LMA, Offset, Align
+    if len(parts) >= 7 and parts[1].startswith(".text"):
+      sections.append((int(parts[3], 16), dump_section(elf_path, parts[1])))
+  return sections
+
+def read_string(data, offset):
+  end = data.find(b"\0", offset)
+  return data[offset:end if end >= 0 else len(data)].decode("utf-8", errors="replace")
+
+def resolve_string(sections, address):
+  for start, data in sections:
+    if start <= address < start + len(data):
+      return read_string(data, address - start)
+  return f"<string at 0x{address:08X}>"
+
+def format_log(format, args, sections):
+  args = iter(args)
+  def convert(match):
+    conversion = match.group(1)
+    if conversion == "%":
+      return "%"
+    value = next(args, 0)
+    if conversion == "s":
+      return resolve_string(sections, value)
+    if conversion == "c":
+      return chr(value & 0xFF)
+    if conversion == "p":
+      return f"0x{value:08X}"
+    if conversion in "di":
+      value = value - (1 << 32) if value & 0x80000000 else value
+      conversion = "d"
+    return (match.group(0)[:-1].translate({ord(c): None for c in "hlzjt"}) + conversion) % value
+  return FORMAT_PATTERN.sub(convert, format)
+
+def decode_ring(ring, formats, sections):
+  """Returns the logs in the ring buffer from oldest to newest, as (level, message) pairs."""
+  head = struct.unpack_from("<I", ring, 0)[0]
+  capacity = (len(ring) - 4) // 4
+  words = struct.unpack_from(f"<{capacity}I", ring, 4)
+  available = min(head, capacity)
+
+  logs = []
+  position = head
+  while available > 0:
+    header = words[(position - 1) % capacity]
+    argc = header & 0xF
+    if argc + 1 > available:
+      break # The oldest log was partially overwritten
+    args = [words[(position - 1 - argc + i) % capacity] for i in range(argc)]
+    level = LEVELS[(header >> 4) & 0x3] if (header >> 4) & 0x3 < len(LEVELS) else "?"
+    logs.append((level, format_log(read_string(formats, header >> 8), args, sections)))
+    position -= argc + 1
+    available -= argc + 1
+  logs.reverse()
+  return logs
+
+if __name__ == "__main__":
+  elf_path = sys.argv[1]
+  dump_path = sys.argv[2]
+
+  ring_address, ring_size = load_symbol(elf_path, "COT_LOG_RING")
+  dump_address = int(sys.argv[3], 0) if len(sys.argv) > 3 else ring_address
+  with open(dump_path, "rb") as f:
+    dump = f.read()
+  ring = dump[ring_address - dump_address:ring_address - dump_address + ring_size]
+  assert len(ring) == ring_size, "The dump doesn't contain the whole of COT_LOG_RING"
+
+  formats = dump_section(elf_path, ".cot_log_fmt")
+  sections = load_loaded_sections(elf_path)
+  for level, message in decode_ring(ring, formats, sections):
+    print(f"{level}: {message}")
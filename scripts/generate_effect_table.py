@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+import sys
+from pathlib import Path
+
+from yaml import load, Loader
+
+from generate_opcode_parse_table import load_enum_ids
+
+# Effect kinds, by key in the rules file: (pmdsky-debug enum, C name prefix, handler parameters)
+EFFECTS = {
+  "moves": ("move_id", "CUSTOM_MOVE_EFFECT", "move_effect_input* data, struct entity* user, struct entity* target, struct move* move"),
+  "items": ("item_id", "CUSTOM_ITEM_EFFECT", "struct entity* user, struct entity* target, struct item* item, bool is_thrown"),
+}
+
+def load_effects(rules_path, key, ids):
+  """Returns a list of (ID, handler name) pairs sorted by ID for the given effect kind, according to the rules file."""
+  with open(rules_path, 'r', encoding="utf-8") as f:
+    rules = load(f.read(), Loader) or {}
+  effects = {}
+  for name, handler in (rules.get(key) or {}).items():
+    if isinstance(name, int):
+      effects[name] = handler
+    elif name in ids:
+      effects[ids[name]] = handler
+    else:
+      raise ValueError(f"Unknown ID '{name}' in {key} of {rules_path}")
+  return sorted(effects.items())
+
+def write_effect_table(lines, key, effects, id_count):
+  _, prefix, params = EFFECTS[key]
+  # One bit per ID, the lowest bit of each byte holds the lowest ID. Read by the trampolines in src/cot/trampolines.s.
+  bitset = [0] * ((id_count + 7) // 8)
+  for effect_id, _ in effects:
+    bitset[effect_id >> 3] |= 1 << (effect_id & 7)
+
+  for handler in sorted(set(handler for _, handler in effects)):
+    lines.append(f"bool {handler}({params});")
+  lines.append("")
+  lines.append(f"const uint8_t {prefix}_BITSET[{len(bitset)}] = {{")
+  for i in range(0, len(bitset), 16):
+    lines.append("  " + ", ".join(f"0x{byte:02X}" for byte in bitset[i:i + 16]) + ",")
+  lines.append("};")
+  lines.append("")
+  lines.append(f"#define {prefix}_AMOUNT {len(effects)}")
+  lines.append(f"const struct {prefix.lower()} {prefix}S[{max(len(effects), 1)}] = {{")
+  for effect_id, handler in effects:
+    lines.append(f"  {{ .id = {effect_id}, .handler = {handler} }},")
+  lines.append("};")
+  lines.append("")
+
+if __name__ == "__main__":
+  rules_path = sys.argv[1]
+  output_path = Path(sys.argv[2])
+
+  lines = []
+  lines.append("/* THIS FILE IS AUTO-GENERATED. DO NOT MODIFY! */")
+  lines.append(f"/* Generated from {rules_path} by scripts/generate_effect_table.py */")
+  lines.append("#pragma once")
+  lines.append("")
+  for key, (enum_name, _, _) in EFFECTS.items():
+    ids = load_enum_ids(enum_name)
+    write_effect_table(lines, key, load_effects(rules_path, key, ids), max(ids.values()) + 1)
+
+  output_path.parent.mkdir(parents=True, exist_ok=True)
+  with open(output_path, "w", encoding="utf-8") as f:
+    for line in lines:
+      f.write(line)
+      f.write('\n')
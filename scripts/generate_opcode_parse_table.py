@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+import sys
+import re
+from pathlib import Path
+
+from yaml import load, Loader
+
+# Must match the enum "opcode_parse_kind" in src/crass.h
+PARSE_KINDS = {
+  "manual": 0,
+  "auto": 1,
+  "dungeon": 2,
+  "ground": 3,
+  "sp": 4,
+  "switch_menu": 5,
+  "message_menu": 6,
+  "call_common": 7,
+}
+
+# Must match the enum "opcode_speedup_kind" in src/crass.h
+SPEEDUP_KINDS = {
+  "run": 0,
+  "drop": 1,
+  "duration_1": 2,
+  "duration_2": 3,
+  "duration_3": 4,
+  "speed_1": 5,
+  "speed_2": 6,
+  "speed_3": 7,
+}
+
+# Tables that can be generated, by name: (C array name, kinds, default kind)
+TABLES = {
+  "parse": ("OPCODE_PARSE_TABLE", PARSE_KINDS, "manual"),
+  "speedup": ("OPCODE_SPEEDUP_TABLE", SPEEDUP_KINDS, "run"),
+}
+
+ENUM_ENTRY_PATTERN = re.compile(r"(\w+)\s*=\s*(0x[0-9a-fA-F]+|\d+)")
+
+def load_enum_ids(enum_name):
+  """Returns a dict mapping each name in the given pmdsky-debug enum to its ID."""
+  enum_pattern = re.compile(r"enum\s+" + enum_name + r"\s*\{(.*?)\}", re.DOTALL)
+  for header_path in Path("pmdsky-debug/headers").rglob("*.h"):
+    with open(header_path, 'r', encoding="utf-8") as f:
+      match = enum_pattern.search(f.read())
+    if match is not None:
+      return {name: int(value, 0) for name, value in ENUM_ENTRY_PATTERN.findall(match.group(1))}
+  raise ValueError(f"enum {enum_name} not found in pmdsky-debug/headers")
+
+def load_opcode_ids():
+  """Returns a dict mapping each name in the pmdsky-debug enum "script_opcode_id" to its ID."""
+  return load_enum_ids("script_opcode_id")
+
+def resolve_opcodes(opcode_ids, entry):
+  """Returns the IDs referenced by a rule entry, either a single opcode or an inclusive range "FIRST..LAST"."""
+  names = entry.split("..")
+  for name in names:
+    if name not in opcode_ids:
+      raise ValueError(f"Unknown opcode '{name}'")
+  if len(names) == 1:
+    return [opcode_ids[names[0]]]
+  return list(range(opcode_ids[names[0]], opcode_ids[names[1]] + 1))
+
+def load_kinds(rules_path, opcode_ids, table="parse"):
+  """Returns a list with the kind of every opcode ID in the given table, according to the rules file."""
+  _, kind_values, default_kind = TABLES[table]
+  with open(rules_path, 'r', encoding="utf-8") as f:
+    rules = load(f.read(), Loader) or {}
+  kinds = [kind_values[default_kind]] * (max(opcode_ids.values()) + 1)
+  for kind_name, entries in rules.items():
+    if kind_name not in kind_values:
+      raise ValueError(f"Unknown {table} kind '{kind_name}' in {rules_path}")
+    for entry in entries or []:
+      for opcode_id in resolve_opcodes(opcode_ids, entry):
+        kinds[opcode_id] = kind_values[kind_name]
+  return kinds
+
+def load_parse_kinds(rules_path, opcode_ids):
+  """Returns a list with the parse kind of every opcode ID, according to the rules file."""
+  return load_kinds(rules_path, opcode_ids, "parse")
+
+if __name__ == "__main__":
+  rules_path = sys.argv[1]
+  output_path = Path(sys.argv[2])
+  table = sys.argv[3] if len(sys.argv) > 3 else "parse"
+  table_name = TABLES[table][0]
+
+  kinds = load_kinds(rules_path, load_opcode_ids(), table)
+  # Two opcodes per byte: the low nibble holds the even opcode ID, the high nibble the odd one
+  packed = [kinds[i] | ((kinds[i + 1] if i + 1 < len(kinds) else 0) << 4) for i in range(0, len(kinds), 2)]
+
+  lines = []
+  lines.append("/* THIS FILE IS AUTO-GENERATED. DO NOT MODIFY! */")
+  lines.append(f"/* Generated from {rules_path} by scripts/generate_opcode_parse_table.py */")
+  lines.append("#pragma once")
+  lines.append("")
+  lines.append(f"#define {table_name}_LENGTH {len(kinds)}")
+  lines.append("")
+  lines.append(f"const uint8_t {table_name}[{len(packed)}] = {{")
+  for i in range(0, len(packed), 16):
+    lines.append("  " + ", ".join(f"0x{byte:02X}" for byte in packed[i:i + 16]) + ",")
+  lines.append("};")
+
+  output_path.parent.mkdir(parents=True, exist_ok=True)
+  with open(output_path, "w", encoding="utf-8") as f:
+    for line in lines:
+      f.write(line)
+      f.write('\n')
@@ -8,6 +8,7 @@ from subprocess import Popen, PIPE
 import glob
 import platform
 import tempfile
+import crass_skip_table
 
 OVERLAY_EXTRA = 36
 
@@ -15,6 +16,7 @@ region = sys.argv[1]
 rom_path = sys.argv[2]
 overlay_elf_path = sys.argv[3]
 rom_out_path = sys.argv[4]
+crass_opcode_parse_path = sys.argv[5] if len(sys.argv) > 5 else "src/crass_opcode_parse.yml"
 
 overlay_symbols_lookup = {} # Key = symbol_name: string, value = offset: int
 
@@ -177,6 +179,7 @@ def apply_binary_patch(file_path):
 
 load_overlay_symbols()
 apply_overlay()
+crass_skip_table.apply(rom, overlays, region, overlay_symbols_lookup, crass_opcode_parse_path)
 apply_binary_patches()
 
 rom.saveToFile(rom_out_path)
@@ -1,12 +1,37 @@
 #include <pmdsky.h>
 #include <cot.h>
 
+#include "effect_table.h"
+
 // Internal dispatch code for item and move effects and special processes to C and Rust.
 // These functions are called in trampolines.s.
 
+// The trampolines only call into C for IDs set in CUSTOM_MOVE_EFFECT_BITSET and CUSTOM_ITEM_EFFECT_BITSET,
+// so these are only reached for moves and items listed in src/custom_effects.yml.
+bool CustomApplyMoveEffect(
+        move_effect_input* data, struct entity* user, struct entity* target, struct move* move
+) {
+    for (int i = 0; i < CUSTOM_MOVE_EFFECT_AMOUNT && CUSTOM_MOVE_EFFECTS[i].id <= data->move_id; i++) {
+        if (CUSTOM_MOVE_EFFECTS[i].id == data->move_id)
+            return CUSTOM_MOVE_EFFECTS[i].handler(data, user, target, move);
+    }
+    return false;
+}
+
+bool CustomApplyItemEffect(
+        struct entity* user, struct entity* target, struct item* item, bool is_thrown
+) {
+    for (int i = 0; i < CUSTOM_ITEM_EFFECT_AMOUNT && CUSTOM_ITEM_EFFECTS[i].id <= item->id.val; i++) {
+        if (CUSTOM_ITEM_EFFECTS[i].id == item->id.val)
+            return CUSTOM_ITEM_EFFECTS[i].handler(user, target, item, is_thrown);
+    }
+    return false;
+}
+
 bool cotInternalDispatchApplyItemEffect(
         struct entity* user, struct entity* target, struct item* item, bool is_thrown
 ) {
+    COT_PROFILE_SCOPE(COT_PROFILE_ITEM_EFFECT);
     COT_LOGFMT(COT_LOG_CAT_EFFECTS, "Running item effect %d", item->id.val);
 
     return CustomApplyItemEffect(user, target, item, is_thrown);
@@ -15,6 +40,7 @@ bool cotInternalDispatchApplyItemEffect(
 bool cotInternalDispatchApplyMoveEffect(
         move_effect_input* data, struct entity* user, struct entity* target, struct move* move
 ) {
+    COT_PROFILE_SCOPE(COT_PROFILE_MOVE_EFFECT);
     COT_LOGFMT(COT_LOG_CAT_EFFECTS, "Running move effect %d", data->move_id);
 
     return CustomApplyMoveEffect(data, user, target, move);
@@ -23,6 +49,7 @@ bool cotInternalDispatchApplyMoveEffect(
 int cotInternalDispatchScriptSpecialProcessCall(
         undefined4* unknown, uint32_t special_process_id, short arg1, short arg2
 ) {
+    COT_PROFILE_SCOPE(COT_PROFILE_SPECIAL_PROCESS);
     // TODO: arg2 doesn't seem to match the argument in the script engine?
     COT_LOGFMT(COT_LOG_CAT_SPECIAL_PROCESS, "Running special process %d (arg1=%d, arg2=%d)",
                special_process_id, arg1, arg2);
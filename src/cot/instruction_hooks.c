@@ -2,6 +2,7 @@
 #include <cot/basedefs.h>
 #include <cot/logging.h>
 #include <cot/custom_instructions.h>
+#include <cot/profile.h>
 
 // Loosely based on https://github.com/Adex-8x/jam-patches/blob/master/strung-up-by-sketches/CustomOpcodes/asm_patches/patch_ov36.asm#L137
 
@@ -52,7 +53,9 @@ __attribute((used)) void DispatchCustomInstruction(int index, struct script_rout
 
     struct custom_instruction* instruction = &CUSTOM_INSTRUCTIONS[index];
     COT_LOGFMT(COT_LOG_CAT_INSTRUCTIONS, "Running custom instruction '%s' with %d arguments (opcode %d, index %d)", instruction->name, instruction->n_params, FIRST_CUSTOM_OPCODE + index, index);
+    COT_PROFILE_BEGIN(COT_PROFILE_CUSTOM_INSTRUCTION);
     instruction->handler(routine, args);
+    COT_PROFILE_END(COT_PROFILE_CUSTOM_INSTRUCTION);
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,26 @@
+#include <pmdsky.h>
+#include <stdarg.h>
+#include <cot/basedefs.h>
+#include <cot/logging.h>
+
+#if !defined(NDEBUG) && COT_BINARY_LOG
+
+struct cot_log_ring COT_LOG_RING;
+
+// Stores a log in COT_LOG_RING, see the binary _COT_INTERNAL_LOG_OUTPUT. Arguments are stored as raw 32-bit words,
+// so strings are only stored as pointers, which scripts/decode_log.py can resolve if they point into overlay 36.
+void cotInternalLogBinary(uint32_t header, ...) {
+    int argc = header & 0xF;
+    uint32_t head = COT_LOG_RING.head;
+
+    va_list args;
+    va_start(args, header);
+    for (int i = 0; i < argc; i++)
+        COT_LOG_RING.words[(head + i) & (COT_LOG_RING_CAPACITY - 1)] = va_arg(args, uint32_t);
+    va_end(args);
+
+    COT_LOG_RING.words[(head + argc) & (COT_LOG_RING_CAPACITY - 1)] = header;
+    COT_LOG_RING.head = head + argc + 1;
+}
+
+#endif
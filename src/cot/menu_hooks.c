@@ -2,6 +2,7 @@
 #include <cot/basedefs.h>
 #include <cot/logging.h>
 #include <cot/menus.h>
+#include <cot/profile.h>
 
 // Loosely based on https://github.com/Adex-8x/mm5-patches/blob/main/src/menus.c
 
@@ -83,6 +84,7 @@ __attribute((used)) void InitializeCustomScriptMenu(int menu_id) {
 }
 
 __attribute((used)) bool DispatchCustomScriptMenu(int menu_id, int* return_val) {
+    COT_PROFILE_SCOPE(COT_PROFILE_CUSTOM_SCRIPT_MENU);
     int index = menu_id - FIRST_CUSTOM_SCRIPT_MENU;
     if (CustomMenuIsOutOfRange(index)) {
         *return_val = -1;
@@ -0,0 +1,53 @@
+#include <pmdsky.h>
+#include <cot/basedefs.h>
+#include <cot/logging.h>
+#include <cot/profile.h>
+
+#if COT_PROFILE && !defined(NDEBUG)
+
+struct cot_profile_entry COT_PROFILE_TABLE[COT_PROFILE_AMOUNT];
+
+static const char* COT_PROFILE_NAMES[COT_PROFILE_AMOUNT] = {
+    [COT_PROFILE_SHOULD_SKIP_CUTSCENE] = "ShouldSkipCutscene",
+    [COT_PROFILE_TRY_CUTSCENE_SKIP_SCAN] = "TryCutsceneSkipScan",
+    [COT_PROFILE_CUSTOM_INSTRUCTION] = "DispatchCustomInstruction",
+    [COT_PROFILE_CUSTOM_SCRIPT_MENU] = "DispatchCustomScriptMenu",
+    [COT_PROFILE_MOVE_EFFECT] = "ApplyMoveEffect",
+    [COT_PROFILE_ITEM_EFFECT] = "ApplyItemEffect",
+    [COT_PROFILE_SPECIAL_PROCESS] = "ScriptSpecialProcessCall",
+};
+
+// Starts timer 2 at the bus clock, and timer 3 counting its overflows
+void cotInternalStartProfileTimer(void) {
+    COT_PROFILE_TM2CNT_H = 0;
+    COT_PROFILE_TM3CNT_H = 0;
+    COT_PROFILE_TM2CNT_L = 0;
+    COT_PROFILE_TM3CNT_L = 0;
+    COT_PROFILE_TM3CNT_H = COT_PROFILE_TIMER_ENABLE | COT_PROFILE_TIMER_COUNT_UP;
+    COT_PROFILE_TM2CNT_H = COT_PROFILE_TIMER_ENABLE;
+}
+
+void cotInternalProfileRecord(enum cot_profile_id id, uint32_t start) {
+    uint32_t cycles = (cotInternalProfileTimer() - start) * 2;
+    struct cot_profile_entry* entry = &COT_PROFILE_TABLE[id];
+    if (entry->calls == 0 || cycles < entry->min_cycles)
+        entry->min_cycles = cycles;
+    if (cycles > entry->max_cycles)
+        entry->max_cycles = cycles;
+    entry->total_cycles += cycles;
+    entry->calls++;
+}
+
+// Prints COT_PROFILE_TABLE, and clears it afterwards if `reset` is true.
+// Totals are printed in units of 1024 cycles, since there's no 64-bit division to convert them to decimal.
+void CotDumpProfile(bool reset) {
+    for (int i = 0; i < COT_PROFILE_AMOUNT; i++) {
+        struct cot_profile_entry* entry = &COT_PROFILE_TABLE[i];
+        COT_LOGFMT(COT_LOG_CAT_PROFILE, "%s: %u calls, total %u Kcycles, min %u, max %u",
+                   COT_PROFILE_NAMES[i], entry->calls, (uint32_t) (entry->total_cycles >> 10), entry->min_cycles, entry->max_cycles);
+    }
+    if (reset)
+        MemZero(COT_PROFILE_TABLE, sizeof(COT_PROFILE_TABLE));
+}
+
+#endif
@@ -0,0 +1,45 @@
+#include <pmdsky.h>
+#include <cot/basedefs.h>
+#include <cot/logging.h>
+#include <cot/special_processes.h>
+
+// Maps each custom special process ID to its index in CUSTOM_SPECIAL_PROCESSES plus one, or 0 if the ID isn't registered.
+// Filled in on the first lookup, so looking up a special process doesn't need to search the whole registry.
+static uint8_t CUSTOM_SPECIAL_PROCESS_INDICES[CUSTOM_SPECIAL_PROCESS_ID_LIMIT - FIRST_CUSTOM_SPECIAL_PROCESS];
+static bool custom_special_process_indices_ready = false;
+
+// Entries with an unusable ID, or with an ID that's already taken, are left out with an error.
+// Entries meant to be simulated without a `simulate` function are run during cutscene skips instead.
+static void BuildCustomSpecialProcessIndices(void) {
+    for (int i = 0; i < CUSTOM_SPECIAL_PROCESS_AMOUNT; i++) {
+        struct custom_special_process* special_process = &CUSTOM_SPECIAL_PROCESSES[i];
+        int id = special_process->id;
+        if (id < FIRST_CUSTOM_SPECIAL_PROCESS || id >= CUSTOM_SPECIAL_PROCESS_ID_LIMIT || i >= 0xFF) {
+            COT_ERRORFMT(COT_LOG_CAT_SPECIAL_PROCESS, "Custom special process '%s' can't use ID %d", special_process->name, id);
+            continue;
+        }
+        uint8_t* index = &CUSTOM_SPECIAL_PROCESS_INDICES[id - FIRST_CUSTOM_SPECIAL_PROCESS];
+        if (*index != 0) {
+            COT_ERRORFMT(COT_LOG_CAT_SPECIAL_PROCESS, "Custom special process '%s' can't use ID %d, already taken by '%s'",
+                         special_process->name, id, CUSTOM_SPECIAL_PROCESSES[*index - 1].name);
+            continue;
+        }
+        if (special_process->skip_kind == CUSTOM_SPECIAL_PROCESS_SKIP_SIMULATE && special_process->simulate == NULL) {
+            COT_ERRORFMT(COT_LOG_CAT_SPECIAL_PROCESS, "Custom special process '%s' has no simulate function, running it during skips instead", special_process->name);
+            special_process->skip_kind = CUSTOM_SPECIAL_PROCESS_SKIP_EXECUTE;
+        }
+        *index = i + 1;
+    }
+    custom_special_process_indices_ready = true;
+}
+
+// Returns the entry of CUSTOM_SPECIAL_PROCESSES registered for the given ID, or NULL if there is none.
+struct custom_special_process* GetCustomSpecialProcess(uint32_t special_process_id) {
+    if (special_process_id < FIRST_CUSTOM_SPECIAL_PROCESS || special_process_id >= CUSTOM_SPECIAL_PROCESS_ID_LIMIT)
+        return NULL;
+    if (!custom_special_process_indices_ready)
+        BuildCustomSpecialProcessIndices();
+
+    int index = CUSTOM_SPECIAL_PROCESS_INDICES[special_process_id - FIRST_CUSTOM_SPECIAL_PROCESS];
+    return index > 0 ? &CUSTOM_SPECIAL_PROCESSES[index - 1] : NULL;
+}
@@ -11,6 +11,17 @@ cotInternalTrampolineScriptSpecialProcessCall:
 
 .align 4
 cotInternalTrampolineApplyItemEffect:
+  // Unless the item ID is set in CUSTOM_ITEM_EFFECT_BITSET, run the original function right away
+  push {r10, r11}
+  ldrh r10, [r6, #0x4] // item->id
+  ldr r11, =CUSTOM_ITEM_EFFECT_BITSET
+  ldrb r11, [r11, r10, lsr #3]
+  and r10, r10, #7
+  mov r11, r11, lsr r10
+  tst r11, #1
+  pop {r10, r11}
+  beq cotInternalTrampolineApplyItemEffectOriginal
+
   // Backup registers
   push {r0-r9, r11, r12}
 
@@ -31,12 +42,24 @@ cotInternalTrampolineApplyItemEffect:
 
   pop {r0-r9, r11, r12}
 
+cotInternalTrampolineApplyItemEffectOriginal:
   // Restore the instruction that was replaced with the patch and call the original function
   cmp r0, #0
   b ApplyItemEffectHookAddr+4
 
 .align 4
 cotInternalTrampolineApplyMoveEffect:
+  // Unless the move ID is set in CUSTOM_MOVE_EFFECT_BITSET, run the original function right away.
+  // r10 is overwritten below either way, so it's the only register used: the byte holding the move's bit
+  // is repeated across the whole word, so rotating by the move ID brings the bit at (move ID & 7) down to bit 0.
+  ldr r10, =CUSTOM_MOVE_EFFECT_BITSET
+  ldrb r10, [r10, r6, lsr #3]
+  orr r10, r10, r10, lsl #8
+  orr r10, r10, r10, lsl #16
+  mov r10, r10, ror r6
+  tst r10, #1
+  beq cotInternalTrampolineApplyMoveEffectOriginal
+
   // Backup registers
   push {r0-r9, r11, r12}
 
@@ -66,6 +89,7 @@ cotInternalTrampolineApplyMoveEffect:
 
   pop {r0-r9, r11, r12}
 
+cotInternalTrampolineApplyMoveEffectOriginal:
   // Restore the instruction that was replaced with the patch and call the original function
   mov r1, #0x1
   b ApplyMoveEffectHookAddr+4
@@ -2,6 +2,8 @@
 #include <cot.h>
 #include "extern.h"
 #include "crass.h"
+#include "opcode_parse_table.h"
+#include "opcode_speedup_table.h"
 
 /***************************************
  *  Cancel Recover Acting Skip System  *
@@ -11,6 +13,11 @@
 
 struct crass_settings CRASS_SETTINGS;
 
+// Filled in by scripts/crass_skip_table.py when patching the ROM.
+struct crass_skip_table CRASS_SKIP_TABLE;
+// const instead of #define so the constant can be read when patching the ROM
+__attribute((used)) const int CRASS_SKIP_TABLE_MAX_LENGTH = CRASS_SKIP_TABLE_CAPACITY;
+
 /*
   Returns if the current main routine originates from Unionall.
   At least one of the following conditions must be met:
@@ -39,6 +46,30 @@ bool IsMainRoutineInvalidToSkip(void) {
   return (checksum == NULL || IsMainRoutineBornFromUnionall() || main_routine->states[0].field_0x4 != 3);
 }
 
+/*
+  Same as IsMainRoutineInvalidToSkip, but the result is cached in CRASS_SETTINGS.eligibility and only computed again once the main routine,
+  its kind, script files, call stack or status change, e.g. when the scene loads or the routine calls into Unionall.
+*/
+bool IsMainRoutineInvalidToSkipCached(void) {
+  struct crass_routine_eligibility* eligibility = &(CRASS_SETTINGS.eligibility);
+  struct script_routine* routine = GROUND_STATE_PTRS.main_routine;
+  struct script_routine_state* state = &(routine->states[0]);
+  bool in_call = state->ssb_info[1].next_opcode_addr != NULL;
+  if(!eligibility->valid || eligibility->routine != routine || eligibility->routine_kind != routine->routine_kind.val ||
+     eligibility->file != state->ssb_info[0].file || eligibility->call_file != state->ssb_info[1].file ||
+     eligibility->in_call != in_call || eligibility->status != state->field_0x4) {
+    eligibility->valid = true;
+    eligibility->routine = routine;
+    eligibility->routine_kind = routine->routine_kind.val;
+    eligibility->file = state->ssb_info[0].file;
+    eligibility->call_file = state->ssb_info[1].file;
+    eligibility->in_call = in_call;
+    eligibility->status = state->field_0x4;
+    eligibility->invalid = IsMainRoutineInvalidToSkip();
+  }
+  return eligibility->invalid;
+}
+
 /*
   A small wrapper function that performs the actions of the script opcode OPCODE_MESSAGE_SET_WAIT_MODE.
 */
@@ -54,31 +85,53 @@ void MessageSetWaitModeWrapper(int speed1, int speed2) {
 
   Not all opcodes are treated equally when parsing a script to skip. Some opcodes, such as actor movement, are unimportant and can be skipped.
   Others, such as variable manipulation and flow control, must be properly run with the RunNextOpcode function.
+
+  The parse type of every opcode is looked up in OPCODE_PARSE_TABLE, which is generated from "crass_opcode_parse.yml" when building.
+  The table packs two opcodes per byte, one per nibble.
 */
 enum opcode_parse_kind GetOpcodeParseType(uint16_t* opcode_id_addr) {
   uint16_t opcode_id = *opcode_id_addr;
-  if(opcode_id == OPCODE_MAIN_ENTER_DUNGEON)
-    return OPCODE_PARSE_DUNGEON;
-  else if(opcode_id == OPCODE_MAIN_ENTER_GROUND)
-    return OPCODE_PARSE_GROUND;
-  else if(opcode_id == OPCODE_PROCESS_SPECIAL)
-    return OPCODE_PARSE_SP;
-  else if(opcode_id == OPCODE_MESSAGE_SWITCH_MENU || opcode_id == OPCODE_MESSAGE_SWITCH_MENU2)
-    return OPCODE_PARSE_SWITCH_MENU;
-  else if(opcode_id == OPCODE_MESSAGE_MENU)
-    return OPCODE_PARSE_MESSAGE_MENU;
-  else if(opcode_id == OPCODE_CALL_COMMON)
-    return OPCODE_PARSE_CALL_COMMON;
-  else if(IsWithinRange(opcode_id, OPCODE_FLAG_CALC_BIT, OPCODE_FLAG_SET_SCENARIO) ||
-          IsWithinRange(opcode_id, OPCODE_BRANCH, OPCODE_CALL) ||
-          IsWithinRange(opcode_id, OPCODE_SWITCH, OPCODE_SWITCH_VARIABLE) ||
-          IsWithinRange(opcode_id, OPCODE_DEBUG_ASSERT, OPCODE_DEBUG_PRINT_SCENARIO) ||
-          IsWithinRange(opcode_id, OPCODE_ITEM_GET_VARIABLE, OPCODE_ITEM_SET_VARIABLE) ||
-          opcode_id == OPCODE_JUMP ||
-          opcode_id == OPCODE_RETURN)
-    return OPCODE_PARSE_AUTO;
-  else
+  #if CUSTOM_GROUND_INSTRUCTIONS
+  // Custom instructions declare whether they should be run during a cutscene skip themselves
+  if(opcode_id >= FIRST_CUSTOM_OPCODE) {
+    int index = opcode_id - FIRST_CUSTOM_OPCODE;
+    if(index < CUSTOM_INSTRUCTION_AMOUNT && CUSTOM_INSTRUCTIONS[index].skip_kind == CUSTOM_INSTRUCTION_SKIP_EXECUTE)
+      return OPCODE_PARSE_AUTO;
     return OPCODE_PARSE_MANUAL;
+  }
+  #endif
+  if(opcode_id >= OPCODE_PARSE_TABLE_LENGTH)
+    return OPCODE_PARSE_MANUAL;
+  return (OPCODE_PARSE_TABLE[opcode_id >> 1] >> ((opcode_id & 1) << 2)) & 0xF;
+}
+
+/*
+  Given an address to a script opcode, return how many parameters it takes. A negative number means the opcode's parameters are variadic,
+  in which case the first parameter holds the amount of parameters that follow.
+  Both base game opcodes in SCRIPT_OP_CODES and custom instructions in CUSTOM_INSTRUCTIONS are accounted for.
+*/
+int GetOpcodeParamCount(uint16_t* opcode_id_addr) {
+  uint16_t opcode_id = *opcode_id_addr;
+  #if CUSTOM_GROUND_INSTRUCTIONS
+  if(opcode_id >= FIRST_CUSTOM_OPCODE) {
+    int index = opcode_id - FIRST_CUSTOM_OPCODE;
+    return index < CUSTOM_INSTRUCTION_AMOUNT ? CUSTOM_INSTRUCTIONS[index].n_params : 0;
+  }
+  #endif
+  return (signed char)SCRIPT_OP_CODES.ops[opcode_id].n_params;
+}
+
+/*
+  Given an address to a script opcode, return whether it's a base game opcode or a registered custom instruction, i.e. whether its parameters can be counted.
+  Must match load_param_counts in scripts/crass_skip_table.py.
+*/
+bool IsKnownOpcode(uint16_t* opcode_id_addr) {
+  uint16_t opcode_id = *opcode_id_addr;
+  #if CUSTOM_GROUND_INSTRUCTIONS
+  if(opcode_id >= FIRST_CUSTOM_OPCODE)
+    return opcode_id - FIRST_CUSTOM_OPCODE < CUSTOM_INSTRUCTION_AMOUNT;
+  #endif
+  return opcode_id < OPCODE_PARSE_TABLE_LENGTH;
 }
 
 /*
@@ -86,14 +139,201 @@ enum opcode_parse_kind GetOpcodeParseType(uint16_t* opcode_id_addr) {
   This function is most notably used in the naive parsing algorithim and for opcodes who are of the parse kind OPCODE_PARSE_MANUAL, among other exceptions.
 */
 uint16_t* CalcNextOpcodeAddress(uint16_t* next_opcode_addr) {
-  struct script_opcode current_op = SCRIPT_OP_CODES.ops[*next_opcode_addr]; // TODO: Account for custom opcodes?
-  signed char num_params = (signed char)current_op.n_params;
+  int num_params = GetOpcodeParamCount(next_opcode_addr);
   return next_opcode_addr += num_params < 0 ? ScriptParamToInt(next_opcode_addr[1]) + 2 : num_params + 1;
 }
 
+// Returns how a cutscene skip treats the given OPCODE_MESSAGE_MENU, see CRASS_MESSAGE_MENU_POLICIES in "crass_policies.c".
+const struct crass_menu_policy* GetMessageMenuPolicy(int menu_id) {
+  static const struct crass_menu_policy default_policy = { .kind = CRASS_POLICY_SKIP };
+  if(menu_id < 0 || menu_id >= CRASS_MESSAGE_MENU_POLICY_AMOUNT || CRASS_MESSAGE_MENU_POLICIES[menu_id].kind == CRASS_POLICY_DEFAULT)
+    return &default_policy;
+  return &(CRASS_MESSAGE_MENU_POLICIES[menu_id]);
+}
+
+// Returns how a cutscene skip treats an OPCODE_CALL_COMMON of the given routine, see CRASS_COMMON_ROUTINE_POLICIES in "crass_policies.c".
+enum crass_skip_policy GetCommonRoutinePolicy(int coroutine_id) {
+  if(coroutine_id < 0 || coroutine_id >= CRASS_COMMON_ROUTINE_POLICY_AMOUNT || CRASS_COMMON_ROUTINE_POLICIES[coroutine_id] == CRASS_POLICY_DEFAULT)
+    return CRASS_POLICY_EXECUTE;
+  return CRASS_COMMON_ROUTINE_POLICIES[coroutine_id];
+}
+
+struct crass_scan_memo_entry {
+  uint16_t* addr;
+  uint8_t outcome; // See the enum "crass_scan_outcome" in "crass.h"
+};
+
+// A user-based branch whose cases are being investigated by the skip scanner: either a switch menu, or a skipped message menu whose result is
+// switched on by the case opcodes following it.
+struct crass_scan_frame {
+  uint16_t* switch_menu_addr; // The OPCODE_MESSAGE_SWITCH_MENU/2 or OPCODE_MESSAGE_MENU being investigated
+  uint16_t* case_menu_addr;   // The case opcode currently being investigated, or the opcode after the last case once all cases failed
+  uint16_t* case_addr;        // The address the current case opcode jumps to
+  bool final_attempt;         // All cases failed, so the opcodes following them are being investigated
+};
+
+// The state of a cutscene skip scan, which may span several frames (see RunCutsceneSkipScan).
+// Everything the scanner needs lives in this fixed-size arena, so its memory use doesn't depend on the structure of the script being skipped.
+struct crass_scan_state {
+  bool active;                 // A scan was started and its outcome hasn't been consumed by TryCutsceneSkipScan yet
+  struct script_routine* routine; // The main routine being skipped, which is parked while the scan runs
+  uint8_t outcome;             // CRASS_SCAN_IN_PROGRESS while the scan runs, then the final outcome of the scan
+  uint16_t depth;              // Number of switch menus in "frames" being investigated
+  uint16_t memo_entries;       // Number of used entries in "memo"
+  uint32_t executed_opcodes;   // Number of opcodes run so far
+  uint32_t skipped_opcodes;    // Number of opcodes skipped over so far
+  uint32_t explored_paths;     // Number of switch menu cases, and opcodes following the cases, moved on to so far
+  struct ssb_runtime_info scan_info[2];   // Where the scan is in the script, including the call stack entry used by OPCODE_CALL
+  struct ssb_runtime_info parked_info[2]; // Where the main routine really is in the script while it's parked
+  struct crass_scan_frame frames[CRASS_SCAN_MAX_DEPTH];
+  struct crass_scan_memo_entry memo[CRASS_SCAN_MEMO_CAPACITY]; // Remembers the outcome of scanning each switch menu and case branch
+};
+
+struct crass_scan_state CRASS_SCAN;
+struct crass_scan_stats CRASS_SCAN_STATS;
+
+/*
+  Returns the memo slot for an opcode address, which is either the slot already holding the address or the empty slot it should be placed in.
+  Returns NULL if the address isn't remembered and there is no more room to remember it.
+*/
+struct crass_scan_memo_entry* GetScanMemoEntry(uint16_t* addr) {
+  uint32_t index = (uint32_t)addr >> 1;
+  for(int i = 0; i < CRASS_SCAN_MEMO_CAPACITY; i++) {
+    struct crass_scan_memo_entry* entry = &CRASS_SCAN.memo[(index + i) & (CRASS_SCAN_MEMO_CAPACITY - 1)];
+    if(entry->addr == addr || entry->addr == NULL)
+      return entry;
+  }
+  return NULL;
+}
+
+/*
+  Returns the remembered scan outcome of the opcode region starting at the given address, or CRASS_SCAN_UNKNOWN if it hasn't been scanned yet.
+*/
+enum crass_scan_outcome GetScanOutcome(uint16_t* addr) {
+  struct crass_scan_memo_entry* entry = GetScanMemoEntry(addr);
+  return entry != NULL && entry->addr == addr ? entry->outcome : CRASS_SCAN_UNKNOWN;
+}
+
+/*
+  Remembers the final scan outcome of the opcode region starting at the given address.
+  If the memo is full, the outcome is forgotten and the region will be scanned again if it's reached again.
+*/
+void SetScanOutcome(uint16_t* addr, enum crass_scan_outcome outcome) {
+  struct crass_scan_memo_entry* entry = GetScanMemoEntry(addr);
+  if(entry != NULL) {
+    if(entry->addr == NULL && ++CRASS_SCAN.memo_entries > CRASS_SCAN_STATS.max_memo_entries)
+      CRASS_SCAN_STATS.max_memo_entries = CRASS_SCAN.memo_entries;
+    entry->addr = addr;
+    entry->outcome = outcome;
+  }
+}
+
+// The main routine is parked on this opcode while a scan spans several frames, so it doesn't continue the cutscene being skipped.
+// OPCODE_HOLD keeps a routine waiting on the same opcode without ending it (ROUTINE_DEMO_CANCEL relies on this as well).
+const uint16_t CRASS_PARKED_OPCODES[] = { OPCODE_HOLD };
+
+/*
+  Returns whether the given opcode is one of the cases of a user-based branch starting at `branch_addr`.
+  Switch menus are followed by OPCODE_CASE_MENU/2, while the result of OPCODE_MESSAGE_MENU can be compared by any case opcode.
+*/
+bool IsScanCaseOpcode(uint16_t* branch_addr, uint16_t* opcode_addr) {
+  switch(*opcode_addr) {
+    case OPCODE_CASE_MENU:
+    case OPCODE_CASE_MENU2:
+      return true;
+    case OPCODE_CASE:
+    case OPCODE_CASE_SCENARIO:
+    case OPCODE_CASE_TEXT:
+    case OPCODE_CASE_VALUE:
+    case OPCODE_CASE_VARIABLE:
+      return *branch_addr == OPCODE_MESSAGE_MENU;
+    default:
+      return false;
+  }
+}
+
+/*
+  Moves the scan on to the next case of a user-based branch that hasn't already failed.
+  Once every case has been investigated, the scan continues with the opcodes following the cases instead.
+*/
+void AdvanceScanFrame(struct script_routine* routine, struct crass_scan_frame* frame) {
+  while(true) {
+    frame->case_menu_addr = CalcNextOpcodeAddress(frame->case_menu_addr);
+    if(!IsScanCaseOpcode(frame->switch_menu_addr, frame->case_menu_addr)) {
+      // We've finished investgating all case menus...begin the final attempt...
+      frame->final_attempt = true;
+      CRASS_SCAN.explored_paths++;
+      routine->states[0].ssb_info[0].next_opcode_addr = frame->case_menu_addr;
+      return;
+    }
+    // Every case opcode takes the offset it jumps to as its last parameter, and only investigate it if it hasn't already failed
+    frame->case_addr = routine->states[0].ssb_info[0].file + (frame->case_menu_addr[GetOpcodeParamCount(frame->case_menu_addr)] << 1);
+    if(GetScanOutcome(frame->case_addr) == CRASS_SCAN_UNKNOWN) {
+      CRASS_SCAN.explored_paths++;
+      routine->states[0].ssb_info[0].next_opcode_addr = frame->case_addr;
+      return;
+    }
+  }
+}
+
+/*
+  Called when the path currently being scanned fails. Remembers the failure and backtracks to the next case of the innermost switch menu.
+  Returns CRASS_SCAN_IN_PROGRESS if there's another path left to investigate, or the failure if every path failed.
+*/
+enum crass_scan_outcome BacktrackCutsceneSkipScan(struct script_routine* routine, enum crass_scan_outcome outcome) {
+  while(CRASS_SCAN.depth > 0) {
+    struct crass_scan_frame* frame = &(CRASS_SCAN.frames[CRASS_SCAN.depth - 1]);
+    if(frame->final_attempt) {
+      // If the final scan attempt fails, the whole switch menu fails
+      SetScanOutcome(frame->switch_menu_addr, outcome);
+      CRASS_SCAN.depth--;
+      continue;
+    }
+    SetScanOutcome(frame->case_addr, outcome);
+    AdvanceScanFrame(routine, frame);
+    return CRASS_SCAN_IN_PROGRESS;
+  }
+  return outcome;
+}
+
+/*
+  Returns whether the cases of the user-based branch at `branch_addr` are currently being investigated, i.e. it's on the stack CRASS_SCAN.frames.
+*/
+bool IsScanBranchInProgress(uint16_t* branch_addr) {
+  for(int i = 0; i < CRASS_SCAN.depth; i++) {
+    if(CRASS_SCAN.frames[i].switch_menu_addr == branch_addr)
+      return true;
+  }
+  return false;
+}
+
 /*
-  Given a script routine and an address to either OPCODE_SWITCH_MENU or OPCODE_SWITCH_MENU2, try to parse the remaining opcodes of the routine.
-  Returning true indicates that the remaining opcodes were successfully parsed, and false otherwise.
+  Starts investigating the cases of the user-based branch at `branch_addr`, which the routine is about to run.
+  Returns CRASS_SCAN_IN_PROGRESS if a case is being investigated, or the failure if the branch can't be investigated.
+*/
+enum crass_scan_outcome BranchCutsceneSkipScan(struct script_routine* routine, uint16_t* branch_addr) {
+  if(IsScanBranchInProgress(branch_addr))
+    return BacktrackCutsceneSkipScan(routine, CRASS_SCAN_LOOPS); // Infinite loop detected, this branch is already being investigated, so try the next case...
+  enum crass_scan_outcome outcome = GetScanOutcome(branch_addr);
+  if(outcome != CRASS_SCAN_UNKNOWN)
+    return BacktrackCutsceneSkipScan(routine, outcome); // This branch was already investigated and none of its cases lead anywhere
+  else if(CRASS_SCAN.depth >= CRASS_SCAN_MAX_DEPTH)
+    return BacktrackCutsceneSkipScan(routine, CRASS_SCAN_TOO_DEEP);
+  CRASS_SCAN.skipped_opcodes++;
+  struct crass_scan_frame* frame = &(CRASS_SCAN.frames[CRASS_SCAN.depth++]);
+  if(CRASS_SCAN.depth > CRASS_SCAN_STATS.max_depth)
+    CRASS_SCAN_STATS.max_depth = CRASS_SCAN.depth;
+  frame->switch_menu_addr = branch_addr;
+  frame->case_menu_addr = branch_addr;
+  frame->final_attempt = false;
+  AdvanceScanFrame(routine, frame);
+  return CRASS_SCAN_IN_PROGRESS;
+}
+
+/*
+  Given a script routine, parse a single one of the remaining opcodes of the routine.
+  Returns CRASS_SCAN_IN_PROGRESS if there are opcodes left to parse, CRASS_SCAN_TERMINATES if the remaining opcodes were successfully parsed,
+  and any other outcome indicates a failure.
   
   This function is the core component of skipping a cutscene. When a cutscene is skipped in the base game via OPCODE_CANCEL_RECOVER_COMMON, the game will jump to
   the coroutine ROUTINE_DEMO_CANCEL and stop running opcodes of the cutscene that was just skipped. This, however, poses a problem for cutscene skips:
@@ -103,156 +343,327 @@ uint16_t* CalcNextOpcodeAddress(uint16_t* next_opcode_addr) {
   Additionally, flow control is maintained when scanning a script with this function, in the event that a script must perform an action like
   a for-loop within its main routine. Branches, switches, jumps, and calls work properly, but another problem arises: User-based branching.
   The opcodes OPCODE_MESSAGE_SWITCH_MENU and OPCODE_MESSAGE_SWITCH_MENU2 branch based on user input, and as such, we cannot assume which
-  menu option will lead to the routine's end and which will infinitely loop.
+  menu option will lead to the routine's end and which will infinitely loop. The same goes for a skipped OPCODE_MESSAGE_MENU followed by
+  case opcodes, since the script branches on the result of a menu that was never shown.
 
-  To combat this problem, every single case of a user-based menu will be investigated sequentially. This function will call itself recursively,
-  able to detect which menu option is an infinite loop by comparing the next opcode address to the address of the most recent "switch menu".
+  To combat this problem, every single case of a user-based menu will be investigated sequentially. Switch menus being investigated are kept
+  on the stack CRASS_SCAN.frames, and the failure of every switch menu and case branch is remembered in CRASS_SCAN.memo. A switch menu that is
+  reached again while it's still on the stack is an infinite loop, and a branch that already failed once is not investigated again.
+  This way, each region of opcodes is only explored once per cutscene skip, no matter how many switch menus share it. If the memo fills up,
+  regions may be explored more than once, but loops are still detected since they only depend on the stack.
 
-  With all of this in mind, there are only two conditions that would cause this function to return false:
+  With all of this in mind, there are only four conditions that would cause the scan to fail:
 
-    - If parsing somehow goes out-of-bounds and reads an opcode from data it isn't meant to
-    - If all cases of a "switch menu" opcode lead to infinite loops
+    - If parsing somehow goes out-of-bounds and reads an opcode from data it isn't meant to (CRASS_SCAN_OUT_OF_BOUNDS)
+    - If all cases of a "switch menu" opcode lead to infinite loops (CRASS_SCAN_LOOPS)
+    - If switch menus are nested deeper than CRASS_SCAN_MAX_DEPTH (CRASS_SCAN_TOO_DEEP)
+    - If more than CRASS_SCAN_MAX_STEPS opcodes are run or paths explored, e.g. by a loop driven by script variables (CRASS_SCAN_OVER_BUDGET)
 
-  However, both conditions indicate a larger problem with the script itself and should not be common occurences.
+  However, these conditions indicate a larger problem with the script itself and should not be common occurences.
   
-  TL;DR this function quickly emulates the remaining opcodes of a cutscene that was just skipped!
+  TL;DR this function quickly emulates the remaining opcodes of a cutscene that was just skipped, one at a time!
 */
-bool TryCutsceneSkipScanInner(struct script_routine* routine, uint16_t* switch_menu_addr) {
+enum crass_scan_outcome StepCutsceneSkipScan(struct script_routine* routine) {
   uint16_t* next_opcode_addr = routine->states[0].ssb_info[0].next_opcode_addr;
-  uint16_t next_opcode_id = *(next_opcode_addr);
+  if(*next_opcode_addr == OPCODE_END || *next_opcode_addr == OPCODE_HOLD)
+    return CRASS_SCAN_TERMINATES;
+  if(!IsWithinRange((uint32_t)next_opcode_addr, (uint32_t)routine->states[0].ssb_info[0].opcodes, (uint32_t)routine->states[0].ssb_info[0].strings))
+    return BacktrackCutsceneSkipScan(routine, CRASS_SCAN_OUT_OF_BOUNDS); // Critical error! The opcode parsing has somehow gone out-of-bounds and is no longer reading valid data!
+  if(CRASS_SCAN.executed_opcodes + CRASS_SCAN.explored_paths >= CRASS_SCAN_MAX_STEPS)
+    return CRASS_SCAN_OVER_BUDGET; // The budget is for the whole scan, so there's no point in trying another path
   undefined4 unknown;
-  while(!(next_opcode_id == OPCODE_END || next_opcode_id == OPCODE_HOLD)) {
-    next_opcode_addr = routine->states[0].ssb_info[0].next_opcode_addr;
-    if(!IsWithinRange((uint32_t)next_opcode_addr, (uint32_t)routine->states[0].ssb_info[0].opcodes, (uint32_t)routine->states[0].ssb_info[0].strings))
-      return false; // Critical error! The opcode parsing has somehow gone out-of-bounds and is no longer reading valid data!
-    switch(GetOpcodeParseType(next_opcode_addr)) {
-      case OPCODE_PARSE_MANUAL:;
-      parse_manual:;
-        routine->states[0].ssb_info[0].next_opcode_addr = CalcNextOpcodeAddress(next_opcode_addr); // Skip over the opcode and just calculate the next opcode address
-        break;
-      case OPCODE_PARSE_AUTO:;
-      parse_auto:;
-        // Perform the normal functions of an opcode instead of skipping over it!
-        // The function RunNextOpcode also advances to the next opcode address, meaning we don't need to call CalcNextOpcodeAddress.
-        RunNextOpcode(routine);
-        break;
-      case OPCODE_PARSE_DUNGEON:;
-        // Cutscene redirects will take priority over entering a dungeon
-        if(!CRASS_SETTINGS.redirect) {
-          next_opcode_addr[2] = 30;
-          CRASS_SETTINGS.enter_dungeon = true;
-          goto parse_auto;
-        }
-        goto parse_manual;
-      case OPCODE_PARSE_GROUND:;
-        // Cutscene redirects will take priority over entering the overworld
-        if(!CRASS_SETTINGS.redirect) {
-          CRASS_SETTINGS.enter_ground = true;
-          goto parse_auto;
-        }
-        goto parse_manual;
-      case OPCODE_PARSE_SP:;
-        // Calling RunNextOpcode on a special process doesn't quite run a special process's code, so some manual setup is required.
-        int sp_params[3];
-        for(int i = 0; i < 3; i++)
-          sp_params[i] = ScriptParamToInt(next_opcode_addr[i+1]);
-        routine->states[0].ssb_info[0].next_opcode_addr = CalcNextOpcodeAddress(next_opcode_addr);
-        routine->states[0].ssb_info[0].next_opcode_addr = ScriptCaseProcess(routine, ScriptSpecialProcessCall(&unknown, sp_params[0], sp_params[1], sp_params[2]));
-        break;
-      case OPCODE_PARSE_SWITCH_MENU:;
-        // Search each OPCODE_CASE_MENU sequentially for the valid path that leads to the end of the script...
-        uint16_t* current_switch_menu_addr = next_opcode_addr;
-        if(current_switch_menu_addr == switch_menu_addr)
-          return false; // Infinite loop detected, return false and try the next case...
-        do {
-          next_opcode_addr = CalcNextOpcodeAddress(next_opcode_addr); 
-          if(!(*next_opcode_addr == OPCODE_CASE_MENU || *next_opcode_addr == OPCODE_CASE_MENU2)) {
-            // We've finished investgating all case menus...begin the final attempt...
-            routine->states[0].ssb_info[0].next_opcode_addr = next_opcode_addr;
-            return TryCutsceneSkipScanInner(routine, current_switch_menu_addr); // If the final scan attempt fails, just stop scanning the cutscene early
-          }
-          // Calculate the correct offset given by an OPCODE_CASE_MENU
-          routine->states[0].ssb_info[0].next_opcode_addr = routine->states[0].ssb_info[0].file + (next_opcode_addr[2] << 1);
-        } while(!TryCutsceneSkipScanInner(routine, current_switch_menu_addr));
-        return true;
-      case OPCODE_PARSE_MESSAGE_MENU:;
-        // Filter which OPCODE_MESSAGE_MENU menus are actually run...
-        uint16_t message_menu_id = ScriptParamToInt(next_opcode_addr[1]);
-        if(message_menu_id == 54) // Execute MENU_DUNGEON_INITIALIZE_TEAM
+  switch(GetOpcodeParseType(next_opcode_addr)) {
+    case OPCODE_PARSE_MANUAL:;
+    parse_manual:;
+      CRASS_SCAN.skipped_opcodes++;
+      routine->states[0].ssb_info[0].next_opcode_addr = CalcNextOpcodeAddress(next_opcode_addr); // Skip over the opcode and just calculate the next opcode address
+      break;
+    case OPCODE_PARSE_AUTO:;
+    parse_auto:;
+      CRASS_SCAN.executed_opcodes++;
+      // Perform the normal functions of an opcode instead of skipping over it!
+      // The function RunNextOpcode also advances to the next opcode address, meaning we don't need to call CalcNextOpcodeAddress.
+      RunNextOpcode(routine);
+      break;
+    case OPCODE_PARSE_DUNGEON:;
+      // Cutscene redirects will take priority over entering a dungeon
+      if(!CRASS_SETTINGS.redirect) {
+        next_opcode_addr[2] = 30;
+        CRASS_SETTINGS.enter_dungeon = true;
+        goto parse_auto;
+      }
+      goto parse_manual;
+    case OPCODE_PARSE_GROUND:;
+      // Cutscene redirects will take priority over entering the overworld
+      if(!CRASS_SETTINGS.redirect) {
+        CRASS_SETTINGS.enter_ground = true;
+        goto parse_auto;
+      }
+      goto parse_manual;
+    case OPCODE_PARSE_SP:;
+      // Calling RunNextOpcode on a special process doesn't quite run a special process's code, so some manual setup is required.
+      int sp_params[3];
+      for(int i = 0; i < 3; i++)
+        sp_params[i] = ScriptParamToInt(next_opcode_addr[i+1]);
+      routine->states[0].ssb_info[0].next_opcode_addr = CalcNextOpcodeAddress(next_opcode_addr);
+      // Custom special processes decide whether they're run during a skip, see CUSTOM_SPECIAL_PROCESSES
+      struct custom_special_process* special_process = GetCustomSpecialProcess(sp_params[0]);
+      int sp_return_val = 0;
+      if(special_process == NULL || special_process->skip_kind == CUSTOM_SPECIAL_PROCESS_SKIP_EXECUTE) {
+        CRASS_SCAN.executed_opcodes++;
+        sp_return_val = ScriptSpecialProcessCall(&unknown, sp_params[0], sp_params[1], sp_params[2]);
+      }
+      else if(special_process->skip_kind == CUSTOM_SPECIAL_PROCESS_SKIP_SIMULATE) {
+        CRASS_SCAN.executed_opcodes++;
+        sp_return_val = special_process->simulate(sp_params[1], sp_params[2]);
+      }
+      else
+        CRASS_SCAN.skipped_opcodes++;
+      routine->states[0].ssb_info[0].next_opcode_addr = ScriptCaseProcess(routine, sp_return_val);
+      break;
+    case OPCODE_PARSE_SWITCH_MENU:;
+      // Search each OPCODE_CASE_MENU sequentially for the valid path that leads to the end of the script...
+      return BranchCutsceneSkipScan(routine, next_opcode_addr);
+    case OPCODE_PARSE_MESSAGE_MENU:;
+      // Filter which OPCODE_MESSAGE_MENU menus are actually run, see CRASS_MESSAGE_MENU_POLICIES
+      uint16_t message_menu_id = ScriptParamToInt(next_opcode_addr[1]);
+      const struct crass_menu_policy* menu_policy = GetMessageMenuPolicy(message_menu_id);
+      switch(menu_policy->kind) {
+        case CRASS_POLICY_EXECUTE:
           goto parse_auto;
-        else if(message_menu_id == 1 || message_menu_id == 4 || message_menu_id == 11) { // Redirect to ROUTINE_MAP_TEST if MENU_HERO_NAME, MENU_TEAM_NAME, or MENU_SAVE_MENU is encountered!
+        case CRASS_POLICY_REDIRECT:
           CRASS_SETTINGS.menu_skipped = message_menu_id;
           CRASS_SETTINGS.redirect = true;
-        }
-        else if(message_menu_id == 63 || message_menu_id == 64) { // Item-giving menus
-          struct bulk_item item;
-          ItemAtTableIdx(0, &item);
-          // Might need to use ScriptCaseProcess on the call to ScriptSpecialProcessCall instead of calculating the address manually?
-          routine->states[0].ssb_info[0].next_opcode_addr = CalcNextOpcodeAddress(next_opcode_addr);
-          ScriptSpecialProcessCall(&unknown, message_menu_id == 63 ? SPECIAL_PROC_ADD_ITEM_TO_BAG : SPECIAL_PROC_ADD_ITEM_TO_STORAGE, item.id.val, item.quantity);
           break;
-        }
-        goto parse_manual; // May need to simulate each case taken like how OPCODE_PARSE_SWITCH_MENU gets parsed
-      case OPCODE_PARSE_CALL_COMMON:;
-        // Filter which Unionall coroutines are called...
-        enum common_routine_id coroutine_id = ScriptParamToInt(next_opcode_addr[1]);
-        if(coroutine_id == ROUTINE_HANYOU_SAVE_FUNC)
-          goto parse_manual;
-        goto parse_auto;
+        case CRASS_POLICY_SIMULATE:
+          CRASS_SCAN.executed_opcodes++;
+          routine->states[0].ssb_info[0].next_opcode_addr = CalcNextOpcodeAddress(next_opcode_addr);
+          menu_policy->simulate(message_menu_id);
+          return CRASS_SCAN_IN_PROGRESS;
       }
-    next_opcode_id = *(routine->states[0].ssb_info[0].next_opcode_addr);
+      // The menu isn't run, so its result is unknown. If the script switches on it, investigate each case like a switch menu...
+      if(IsScanCaseOpcode(next_opcode_addr, CalcNextOpcodeAddress(next_opcode_addr)))
+        return BranchCutsceneSkipScan(routine, next_opcode_addr);
+      goto parse_manual;
+    case OPCODE_PARSE_CALL_COMMON:;
+      // Filter which Unionall coroutines are called, see CRASS_COMMON_ROUTINE_POLICIES
+      enum common_routine_id coroutine_id = ScriptParamToInt(next_opcode_addr[1]);
+      if(GetCommonRoutinePolicy(coroutine_id) == CRASS_POLICY_SKIP)
+        goto parse_manual;
+      goto parse_auto;
   }
-  return true;
+  return CRASS_SCAN_IN_PROGRESS;
 }
 
 /*
-  Attempt a cutscene skip, returning whether the cutscene's remaining opcodes could all be parsed!
-  While the function TryCutsceneSkipScanInner ultimately handles the bulk of the opcode parsing and has the potential for recursion,
-  this function is only called once per cutscene skip and performs some initial setup before committing to emulate important opcodes.
+  Starts scanning the remaining opcodes of the given main routine, see StepCutsceneSkipScan.
+  Only the routine's runtime info is copied for the scan, and the routine itself is parked on OPCODE_HOLD until the scan finishes.
+*/
+void StartCutsceneSkipScan(struct script_routine* main_routine) {
+  MemZero(&CRASS_SCAN, sizeof(struct crass_scan_state));
+  MemcpySimple(CRASS_SCAN.scan_info, main_routine->states[0].ssb_info, sizeof(CRASS_SCAN.scan_info));
+  MemcpySimple(CRASS_SCAN.parked_info, main_routine->states[0].ssb_info, sizeof(CRASS_SCAN.parked_info));
+  CRASS_SCAN.active = true;
+  CRASS_SCAN.routine = main_routine;
+  CRASS_SCAN.outcome = CRASS_SCAN_IN_PROGRESS;
+  main_routine->states[0].ssb_info[0].next_opcode_addr = (uint16_t*)CRASS_PARKED_OPCODES;
+}
+
+/*
+  Continues the active scan for at most CRASS_SCAN_OPCODES_PER_FRAME opcodes, returning its outcome.
+  Long or menu-heavy scenes are scanned over several frames this way, instead of stalling a single frame.
+  If the scan is still in progress, CRASS_SCAN_IN_PROGRESS is returned and the scan is resumed by ShouldSkipCutscene on the next frame.
+  Once the scan finishes, the main routine is unparked and the outcome is kept until TryCutsceneSkipScan consumes it.
+
+  The opcodes are run on the main routine itself, with the scan's runtime info swapped in for the duration of this function.
+  Other fields of the routine, like its local variables, are updated just like the skipped cutscene would have updated them.
+*/
+enum crass_scan_outcome RunCutsceneSkipScan(void) {
+  if(CRASS_SCAN.outcome != CRASS_SCAN_IN_PROGRESS)
+    return CRASS_SCAN.outcome;
+  struct script_routine* main_routine = CRASS_SCAN.routine;
+  MemcpySimple(main_routine->states[0].ssb_info, CRASS_SCAN.scan_info, sizeof(CRASS_SCAN.scan_info));
+  for(int i = 0; i < CRASS_SCAN_OPCODES_PER_FRAME && CRASS_SCAN.outcome == CRASS_SCAN_IN_PROGRESS; i++)
+    CRASS_SCAN.outcome = StepCutsceneSkipScan(main_routine);
+  MemcpySimple(CRASS_SCAN.scan_info, main_routine->states[0].ssb_info, sizeof(CRASS_SCAN.scan_info));
+  MemcpySimple(main_routine->states[0].ssb_info, CRASS_SCAN.parked_info, sizeof(CRASS_SCAN.parked_info));
+  if(CRASS_SCAN.outcome == CRASS_SCAN_IN_PROGRESS)
+    main_routine->states[0].ssb_info[0].next_opcode_addr = (uint16_t*)CRASS_PARKED_OPCODES;
+  else {
+    CRASS_SCAN_STATS.last_executed_opcodes = CRASS_SCAN.executed_opcodes;
+    CRASS_SCAN_STATS.last_skipped_opcodes = CRASS_SCAN.skipped_opcodes;
+    if(CRASS_SCAN.executed_opcodes + CRASS_SCAN.explored_paths > CRASS_SCAN_STATS.max_steps)
+      CRASS_SCAN_STATS.max_steps = CRASS_SCAN.executed_opcodes + CRASS_SCAN.explored_paths;
+    if(CRASS_SCAN.outcome == CRASS_SCAN_OVER_BUDGET)
+      CRASS_SCAN_STATS.over_budget_count++;
+    COT_LOGFMT(COT_LOG_CAT_CRASS, "Skip scan finished with outcome %d after %d executed and %d skipped opcodes, %d explored paths (max steps %d/%d)",
+      CRASS_SCAN.outcome, CRASS_SCAN.executed_opcodes, CRASS_SCAN.skipped_opcodes, CRASS_SCAN.explored_paths, CRASS_SCAN_STATS.max_steps, CRASS_SCAN_MAX_STEPS);
+    COT_LOGFMT(COT_LOG_CAT_CRASS, "Skip scan arena usage: max depth %d/%d, max memo entries %d/%d",
+      CRASS_SCAN_STATS.max_depth, CRASS_SCAN_MAX_DEPTH, CRASS_SCAN_STATS.max_memo_entries, CRASS_SCAN_MEMO_CAPACITY);
+  }
+  return CRASS_SCAN.outcome;
+}
+
+/*
+  Returns whether the main routine is still the one the active scan was started on, in the state the scan left it in: parked on CRASS_PARKED_OPCODES
+  while the scan runs, or back where it was once the scan is over. If not, the scene changed under the scan, and the scan must not touch the routine.
+*/
+bool IsScanRoutineUnchanged(void) {
+  struct script_routine* main_routine = GROUND_STATE_PTRS.main_routine;
+  if(main_routine != CRASS_SCAN.routine)
+    return false;
+  struct ssb_runtime_info* info = &(main_routine->states[0].ssb_info[0]);
+  uint16_t* expected_opcode_addr = CRASS_SCAN.outcome == CRASS_SCAN_IN_PROGRESS ? (uint16_t*)CRASS_PARKED_OPCODES : CRASS_SCAN.parked_info[0].next_opcode_addr;
+  return info->file == CRASS_SCAN.parked_info[0].file && info->opcodes == CRASS_SCAN.parked_info[0].opcodes && info->next_opcode_addr == expected_opcode_addr;
+}
+
+/*
+  Stops the active scan, if any, and forgets its outcome. If the main routine is still parked by the scan, it's put back where it was,
+  so it doesn't stay stuck on OPCODE_HOLD and plays the rest of the cutscene instead.
+*/
+void AbortCutsceneSkipScan(void) {
+  if(CRASS_SCAN.active && CRASS_SCAN.outcome == CRASS_SCAN_IN_PROGRESS && IsScanRoutineUnchanged())
+    MemcpySimple(CRASS_SCAN.routine->states[0].ssb_info, CRASS_SCAN.parked_info, sizeof(CRASS_SCAN.parked_info));
+  MemZero(&CRASS_SCAN, sizeof(struct crass_scan_state));
+}
+
+/*
+  Clears all of the current cutscene skip settings, except for the ones that aren't specific to a single cutscene, like the speedup multiplier and auto-skip.
+  A skip scan belongs to the current cutscene as well, so it's aborted too.
+*/
+void ResetCrassSettings(void) {
+  uint8_t speedup_multiplier = CRASS_SETTINGS.speedup_multiplier;
+  bool auto_skip = CRASS_SETTINGS.auto_skip;
+  AbortCutsceneSkipScan();
+  MemZero(&CRASS_SETTINGS, sizeof(struct crass_settings));
+  CRASS_SETTINGS.speedup_multiplier = speedup_multiplier;
+  CRASS_SETTINGS.auto_skip = auto_skip;
+}
+
+/*
+  Returns the hash of a scene name, as used by CRASS_SKIP_TABLE. This is the 32-bit FNV-1a hash of the lowercase scene name,
+  which ends at 8 characters, a null byte or the start of a crass_kind parameter. Must match scene_hash in scripts/crass_skip_table.py!
+*/
+uint32_t HashSceneName(char* scene_name) {
+  uint32_t hash = 0x811C9DC5;
+  for(int i = 0; i < 8 && scene_name[i] != '\0' && scene_name[i] != ':'; i++) {
+    char current_char = scene_name[i];
+    if(IsWithinRange(current_char, 'A', 'Z'))
+      current_char += 'a' - 'A';
+    hash = (hash ^ (uint8_t)current_char) * 0x01000193;
+  }
+  return hash;
+}
+
+/*
+  Returns the entry of CRASS_SKIP_TABLE with the given scene hash, or NULL if the scene isn't in the table.
+*/
+struct crass_skip_table_entry* FindSkipTableEntry(uint32_t scene_hash) {
+  int low = 0;
+  int high = (int)CRASS_SKIP_TABLE.length - 1;
+  while(low <= high) {
+    int middle = (low + high) >> 1;
+    struct crass_skip_table_entry* entry = &(CRASS_SKIP_TABLE.entries[middle]);
+    if(entry->scene_hash == scene_hash)
+      return entry;
+    else if(entry->scene_hash < scene_hash)
+      low = middle + 1;
+    else
+      high = middle - 1;
+  }
+  return NULL;
+}
+
+/*
+  Computes the plan of the scene that just started playing, caching a small summary of its script in CRASS_SETTINGS.plan.
+  This runs once per scene, on the first frame the scene is valid to skip, so the frame on which Select is pressed doesn't have to scan the whole script.
 
   If the opcode after the skippable cutscene (played by OPCODE_SUPERVISION_EXECUTE_ACTING_SUB in Unionall) is OPCODE_HOLD or OPCODE_END, then
   the cutscene may only be permitted to skip if it contains at least one instance of OPCODE_MAIN_ENTER_DUNGEON or OPCODE_MAIN_ENTER_GROUND.
-  This function searches for either opcode by beginning at the opcode start address and investigating every opcode until it reaches
-  the string start address, without care for flow control. Important opcodes like variable manipulation are not properly executed.
-  If neither opcode is found, then the cutscene cannot be skipped and will fall back to performing a cutscene speedup.
+  If neither opcode is found, then the cutscene cannot be skipped and pressing Select will perform a cutscene speedup instead.
 
-  If the return value of TryCutsceneSkipScanInner is false, then a redirect will be performed to reload the game at ROUTINE_MAP_TEST with a skip kind of CRASS_ERROR.
+  Since the result only matters for scenes followed by OPCODE_HOLD or OPCODE_END, other scenes aren't looked at.
+  Scenes with either opcode are listed in CRASS_SKIP_TABLE, which was computed when patching the ROM. If a scene isn't in the table, or if its script
+  was edited since the table was built, this function searches for either opcode by beginning at the opcode start address and investigating
+  every opcode until it reaches the string start address, without care for flow control. Important opcodes like variable manipulation are not properly executed.
+  The search stops early at an opcode whose parameters can't be counted (see IsKnownOpcode), just like scripts/crass_skip_table.py does.
 */
-__attribute((used)) bool TryCutsceneSkipScan(void) {
-  if(CRASS_SETTINGS.skip_active) {
-    CRASS_SETTINGS.enter_dungeon = false;
-    CRASS_SETTINGS.enter_ground = false;
-    CRASS_SETTINGS.menu_skipped = 0;
-    struct script_routine main_routine;
-    uint16_t* next_opcode_addr;
-    uint16_t next_opcode_id;
-    if(IsMainRoutineInvalidToSkip()) {
+void AnalyzeScenePlan(struct script_routine* routine) {
+  struct crass_scene_plan* plan = &(CRASS_SETTINGS.plan);
+  uint16_t* next_opcode_addr = (uint16_t*)(routine->states[0].ssb_info[0].opcodes);
+  uint16_t* strings_addr = (uint16_t*)(routine->states[0].ssb_info[0].strings);
+  CRASS_SETTINGS.plan_pending = false;
+  MemZero(plan, sizeof(struct crass_scene_plan));
+  if(!CRASS_SETTINGS.end_after_cutscene)
+    return;
+  struct crass_skip_table_entry* entry = FindSkipTableEntry(CRASS_SETTINGS.scene_hash);
+  if(entry != NULL && entry->opcode_length == strings_addr - next_opcode_addr)
+    plan->has_exit_opcode = true;
+  else {
+    while(next_opcode_addr < strings_addr && !plan->has_exit_opcode && IsKnownOpcode(next_opcode_addr)) {
+      enum opcode_parse_kind parse_kind = GetOpcodeParseType(next_opcode_addr);
+      plan->has_exit_opcode = parse_kind == OPCODE_PARSE_DUNGEON || parse_kind == OPCODE_PARSE_GROUND;
+      next_opcode_addr = CalcNextOpcodeAddress(next_opcode_addr);
+    }
+  }
+  if(!plan->has_exit_opcode) {
+    // OPCODE_MAIN_ENTER_DUNGEON and OPCODE_MAIN_ENTER_GROUND not found, so fall back to a speedup!
+    plan->unskippable = true;
+    CRASS_SETTINGS.can_skip = false;
+    CRASS_SETTINGS.can_speedup = true;
+    if(CRASS_SETTINGS.skip_active) {
+      // Auto-skip already armed a skip, so speed up instead
       CRASS_SETTINGS.skip_active = false;
-      return false;
+      CRASS_SETTINGS.speedup_active = true;
+      MessageSetWaitModeWrapper(0, 0);
     }
-    MemcpySimple(&main_routine, GROUND_STATE_PTRS.main_routine, sizeof(struct script_routine));
-    // Conditional naive pass: If the current cutscene is followed by an ending control opcode, scan the whole script to ensure it has OPCODE_MAIN_ENTER_DUNGEON or OPCODE_MAIN_ENTER_GROUND!
-    if(CRASS_SETTINGS.end_after_cutscene) {
-      next_opcode_addr = (uint16_t*)(main_routine.states[0].ssb_info[0].opcodes);
-      next_opcode_id = *(next_opcode_addr);
-      while(true) {
-        if(next_opcode_addr >= (uint16_t*)main_routine.states[0].ssb_info[0].strings) {
-          // OPCODE_MAIN_ENTER_DUNGEON and OPCODE_MAIN_ENTER_DUNGEON not found, so fall back to a speedup!
-          CRASS_SETTINGS.skip_active = false;
-          CRASS_SETTINGS.can_skip = false;
-          CRASS_SETTINGS.speedup_active = true;
-          PlaySeVolumeWrapper(0x4);
-          MessageSetWaitModeWrapper(0, 0);
-          return false;
-        }
-        if(next_opcode_id == OPCODE_MAIN_ENTER_DUNGEON || next_opcode_id == OPCODE_MAIN_ENTER_DUNGEON)
-          break; // Found an opcode that stops playing cutscenes; keep going with the cutscene skip attempt!
-        next_opcode_addr = CalcNextOpcodeAddress(next_opcode_addr);
-        next_opcode_id = *(next_opcode_addr);
+  }
+}
+
+/*
+  Attempt a cutscene skip, returning whether the cutscene's remaining opcodes could all be parsed!
+  While the function StepCutsceneSkipScan ultimately handles the bulk of the opcode parsing, this function performs some initial setup
+  before committing to emulate important opcodes.
+
+  Whether the scene can be skipped at all is already decided by AnalyzeScenePlan when the scene starts, so only the opcodes that still have to run are scanned here.
+  The scan may take several frames (see RunCutsceneSkipScan). Until it finishes, this function returns false so the ground main loop keeps running
+  while the main routine waits, and the scan is resumed every frame by ShouldSkipCutscene, which comes back here once the scan is over.
+
+  If the scan fails to reach the end of the script, including when it runs out of its step budget, then a redirect will be performed to reload the game at
+  ROUTINE_MAP_TEST with a skip kind of CRASS_ERROR. Falling back to a speedup isn't possible at that point, since the opcodes the scan already ran
+  (variables, special processes, etc.) would run a second time as the cutscene plays.
+*/
+__attribute((used)) bool TryCutsceneSkipScan(void) {
+  COT_PROFILE_SCOPE(COT_PROFILE_TRY_CUTSCENE_SKIP_SCAN);
+  if(CRASS_SETTINGS.skip_active) {
+    if(!CRASS_SCAN.active) {
+      CRASS_SETTINGS.enter_dungeon = false;
+      CRASS_SETTINGS.enter_ground = false;
+      CRASS_SETTINGS.menu_skipped = 0;
+      if(IsMainRoutineInvalidToSkip()) {
+        CRASS_SETTINGS.skip_active = false;
+        return false;
+      }
+      if(CRASS_SETTINGS.plan_pending)
+        AnalyzeScenePlan(GROUND_STATE_PTRS.main_routine);
+      if(CRASS_SETTINGS.plan.unskippable) {
+        CRASS_SETTINGS.skip_active = false;
+        CRASS_SETTINGS.speedup_active = true;
+        PlaySeVolumeWrapper(0x4);
+        MessageSetWaitModeWrapper(0, 0);
+        return false;
       }
+      // General smart pass: Run through any important variable-setting opcodes!
+      StartCutsceneSkipScan(GROUND_STATE_PTRS.main_routine);
+    }
+    bool cutscene_skipped_successfully = false;
+    if(CRASS_SCAN.active) {
+      enum crass_scan_outcome outcome = RunCutsceneSkipScan();
+      if(outcome == CRASS_SCAN_IN_PROGRESS)
+        return false; // Keep waiting at GroundMainLoopStuff, the scan continues next frame
+      CRASS_SCAN.active = false;
+      cutscene_skipped_successfully = outcome == CRASS_SCAN_TERMINATES;
     }
-    // General smart recursive pass: Run through any important variable-setting opcodes!
-    bool cutscene_skipped_successfully = TryCutsceneSkipScanInner(&main_routine, NULL);
     CRASS_SETTINGS.can_skip = false;
     CRASS_SETTINGS.can_speedup = false;
     if(!cutscene_skipped_successfully) {
@@ -318,6 +729,16 @@ __attribute((used)) int DebugPrintGameCancel(char* fmt) {
   }
 }
 
+/*
+  Returns whether every cutscene should be skipped or sped up without pressing Select.
+  Auto-skip is enabled with special process 253, or by setting the script variable CRASS_AUTO_SKIP_VARIABLE to a non-zero value.
+*/
+bool IsAutoSkipEnabled(void) {
+  if(CRASS_SETTINGS.auto_skip)
+    return true;
+  return CRASS_AUTO_SKIP_VARIABLE >= 0 && LoadScriptVariableValue(NULL, CRASS_AUTO_SKIP_VARIABLE) != 0;
+}
+
 /*
   This function obtains the name of an Acting scene and an optional "crass_kind" parameter.
 
@@ -326,6 +747,8 @@ __attribute((used)) int DebugPrintGameCancel(char* fmt) {
 
   For example, if the scene name "s12a0701:1" is encountered, scene s12a0701 will be loaded and have a crass_kind of CRASS_OFF (1), making it unskippable.
   Omitting a crass_kind parameter is the same as using a parameter of CRASS_DEFAULT (0), making the cutscene have its default skip settings.
+
+  If auto-skip is enabled (see IsAutoSkipEnabled), the skip or speedup is activated right away instead of waiting for Select to be pressed.
 */
 __attribute((used)) void CustomGetSceneName(char* truncated_scene_name, char* full_scene_name) {
   GetSceneName(truncated_scene_name, full_scene_name); // Clamps the scene name down to 8 characters; may not contain null byte
@@ -348,7 +771,7 @@ __attribute((used)) void CustomGetSceneName(char* truncated_scene_name, char* fu
     truncated_scene_name[len] = '\0'; // Ensure we don't try to treat any part of the skip parameter as the scene name
   uint16_t* next_opcode_addr = GROUND_STATE_PTRS.main_routine->states[0].ssb_info[0].next_opcode_addr;
   uint16_t next_opcode_id = *next_opcode_addr;
-  MemZero(&CRASS_SETTINGS, sizeof(struct crass_settings));
+  ResetCrassSettings();
   // Only allow a cutscene to be skipped if it's loaded by Unionall, i.e. don't skip a cutscene that loads a cutscene
   if(!IsMainRoutineBornFromUnionall()) {
     CRASS_SETTINGS.crass_kind = CRASS_OFF;
@@ -368,8 +791,10 @@ __attribute((used)) void CustomGetSceneName(char* truncated_scene_name, char* fu
           goto skip_speedup;
       }
       else if(next_opcode_id == OPCODE_END || next_opcode_id == OPCODE_HOLD)
-        CRASS_SETTINGS.end_after_cutscene = true; // Cutscene may need to be sped up, so note it for a later check in TryCutsceneSkipScan
+        CRASS_SETTINGS.end_after_cutscene = true; // Cutscene may need to be sped up, so note it for a later check in AnalyzeScenePlan
       CRASS_SETTINGS.can_skip = true;
+      CRASS_SETTINGS.plan_pending = true; // The scene's script isn't loaded yet, so analyze it once it starts playing
+      CRASS_SETTINGS.scene_hash = HashSceneName(truncated_scene_name);
       // Save the state of the script runtime info to perform a proper return after a skip
       MemcpySimple(&(CRASS_SETTINGS.return_info), &(GROUND_STATE_PTRS.main_routine->states[0].ssb_info[0]), sizeof(struct ssb_runtime_info));
       break;
@@ -382,30 +807,67 @@ __attribute((used)) void CustomGetSceneName(char* truncated_scene_name, char* fu
         CRASS_SETTINGS.redirect = true;
       goto skip_default;
   }
+  if(IsAutoSkipEnabled()) {
+    // Nobody has to press Select, so arm the skip or speedup right away. AnalyzeScenePlan turns the skip into a speedup if needed.
+    if(CRASS_SETTINGS.can_skip)
+      CRASS_SETTINGS.skip_active = true;
+    else if(CRASS_SETTINGS.can_speedup) {
+      CRASS_SETTINGS.speedup_active = true;
+      MessageSetWaitModeWrapper(0, 0);
+    }
+  }
 }
 
 /*
   Returns whether a cutscene should be skipped, called nearly every frame while a script is active due to having similar conditions as OPCODE_CANCEL_RECOVER_COMMON.
   A cutscene can only be skipped if all the following conditions are met:
   
-    - If the main routine is "valid" to be skipped (see IsMainRoutineInvalidToSkip)
+    - If the main routine is "valid" to be skipped (see IsMainRoutineInvalidToSkip, whose result is cached by IsMainRoutineInvalidToSkipCached)
     - If the Select button is pressed
     - If the current cutscene can be skipped
 
   This function also handles the activation behind cutscene speedups, since they are also triggered by pressing the Select button.
   However, even if a cutscene speedup is activated, this function will still return false because a speedup is not a skip.
+  While Select is held down, a speedup runs at CRASS_SPEEDUP_MAX regardless of the speedup multiplier.
+
+  Since this function runs so often, the Select button is checked first, and the main routine is only looked at if there is anything to do.
+  On the first frame a skippable scene is valid to skip, its plan is computed (see AnalyzeScenePlan).
+  While a cutscene skip scan spans several frames, this function only resumes the scan, and returns true once the scan is over.
+  This assumes the function keeps being reached every frame while the main routine is parked, like on the frame the skip started.
+  If the main routine was swapped or moved in the meantime, the scan is aborted instead of being run against a script it wasn't started on.
 */
 __attribute((used)) bool ShouldSkipCutscene(void) {
-  if(IsMainRoutineInvalidToSkip())
+  COT_PROFILE_SCOPE(COT_PROFILE_SHOULD_SKIP_CUTSCENE);
+  if(CRASS_SCAN.active) {
+    if(IsScanRoutineUnchanged())
+      return RunCutsceneSkipScan() != CRASS_SCAN_IN_PROGRESS;
+    COT_WARN(COT_LOG_CAT_CRASS, "Main routine changed during a skip scan, aborting the skip");
+    AbortCutsceneSkipScan();
+    CRASS_SETTINGS.skip_active = false;
     return false;
+  }
   uint16_t button_bitfield = 0;
   GetPressedButtons(0, (undefined*)&button_bitfield);
-  if(button_bitfield & 0b100) { // If the Select button is pressed
+  bool select_pressed = (button_bitfield & 0b100) != 0;
+  // Most frames, there's nothing to do: Select wasn't pressed, and no skip, speedup or scene plan is pending
+  if(!(select_pressed || CRASS_SETTINGS.skip_active || CRASS_SETTINGS.speedup_active || CRASS_SETTINGS.plan_pending))
+    return false;
+  // Refreshed before the main routine is checked, so that the boost doesn't stay on after Select is released
+  if(CRASS_SETTINGS.speedup_active) {
+    GetHeldButtons(0, (undefined*)&button_bitfield);
+    CRASS_SETTINGS.speedup_boost = (button_bitfield & 0b100) != 0; // Holding Select speeds up as much as possible
+  }
+  if(IsMainRoutineInvalidToSkipCached())
+    return false;
+  if(CRASS_SETTINGS.plan_pending)
+    AnalyzeScenePlan(GROUND_STATE_PTRS.main_routine);
+  if(select_pressed) {
     // |= needed because we don't want to toggle off the skip
     if(CRASS_SETTINGS.can_skip)
       CRASS_SETTINGS.skip_active |= true;
     else if(CRASS_SETTINGS.can_speedup) {
       CRASS_SETTINGS.speedup_active |= true;
+      CRASS_SETTINGS.speedup_boost = true; // Select was just pressed, so it's held this frame
       PlaySeVolumeWrapper(0x4);
       MessageSetWaitModeWrapper(0, 0);
     }
@@ -422,33 +884,137 @@ __attribute((used)) bool ShouldSkipCutscene(void) {
 */
 __attribute((used)) int TryDisableCutsceneSkipRoutineEnd(int status, struct script_routine* routine) {
   if(routine->routine_kind.val == ROUTINE_MAIN || routine->routine_kind.val == ROUTINE_UNIONALL) {
-    MemZero(&CRASS_SETTINGS, sizeof(struct crass_settings));
+    ResetCrassSettings();
     MessageSetWaitModeWrapper(-1, -1);
   }
   return status;
 }
 
 /*
-  If a cutscene speedup is in progress, bump up the movement speed to 13.
+  Given a script opcode ID, return how it's treated during a cutscene speedup. See the enum "opcode_speedup_kind" in "crass.h" for more info.
+  Like OPCODE_PARSE_TABLE, OPCODE_SPEEDUP_TABLE is generated from "crass_opcode_speedup.yml" when building and packs two opcodes per byte.
+*/
+enum opcode_speedup_kind GetOpcodeSpeedupKind(uint16_t opcode_id) {
+  if(opcode_id >= OPCODE_SPEEDUP_TABLE_LENGTH)
+    return OPCODE_SPEEDUP_RUN;
+  return (OPCODE_SPEEDUP_TABLE[opcode_id >> 1] >> ((opcode_id & 1) << 2)) & 0xF;
+}
+
+/*
+  Returns the base 2 logarithm of the speedup multiplier currently in effect, or CRASS_SPEEDUP_MAX.
+*/
+enum crass_speedup_multiplier GetSpeedupMultiplier(void) {
+  return CRASS_SETTINGS.speedup_boost ? CRASS_SPEEDUP_MAX : CRASS_SETTINGS.speedup_multiplier;
+}
+
+/*
+  Returns a duration divided by the speedup multiplier, but no shorter than `shortest`. Durations that are already shorter are left as is.
+*/
+int ScaleSpeedupDuration(int duration, int shortest) {
+  enum crass_speedup_multiplier multiplier = GetSpeedupMultiplier();
+  if(duration <= shortest)
+    return duration;
+  else if(multiplier == CRASS_SPEEDUP_MAX || (duration >> multiplier) < shortest)
+    return shortest;
+  return duration >> multiplier;
+}
+
+/*
+  Returns a speed multiplied by the speedup multiplier, but no faster than `fastest`. Speeds that are already faster, or not positive, are left as is.
+*/
+int ScaleSpeedupSpeed(int speed, int fastest) {
+  enum crass_speedup_multiplier multiplier = GetSpeedupMultiplier();
+  if(speed <= 0 || speed >= fastest)
+    return speed;
+  else if(multiplier == CRASS_SPEEDUP_MAX || (speed << multiplier) > fastest)
+    return fastest;
+  return speed << multiplier;
+}
+
+// A script parameter scaled for a speedup, along with its original value.
+struct crass_speedup_param_backup {
+  uint16_t* param;
+  uint16_t value;
+};
+
+struct crass_speedup_param_backup CRASS_SPEEDUP_PARAM_BACKUP;
+
+/*
+  Puts back the script parameter last changed by SetSpeedupParam, if any.
+*/
+void RestoreSpeedupParam(void) {
+  if(CRASS_SPEEDUP_PARAM_BACKUP.param != NULL) {
+    *(CRASS_SPEEDUP_PARAM_BACKUP.param) = CRASS_SPEEDUP_PARAM_BACKUP.value;
+    CRASS_SPEEDUP_PARAM_BACKUP.param = NULL;
+  }
+}
+
+/*
+  Changes a parameter of the opcode about to run, since opcodes read their parameters straight from the loaded script.
+  The original value is put back by ApplyOpcodeSpeedup when the next opcode of any routine is about to run, by which point the opcode has read it.
+  This way, an opcode that runs again (e.g. in a loop) is scaled from its original parameter instead of being scaled again every time.
+*/
+void SetSpeedupParam(uint16_t* param, uint16_t value) {
+  RestoreSpeedupParam();
+  CRASS_SPEEDUP_PARAM_BACKUP.param = param;
+  CRASS_SPEEDUP_PARAM_BACKUP.value = *param;
+  *param = value;
+}
+
+/*
+  If a cutscene speedup is in progress, apply the speedup kind of an opcode about to run, returning whether the opcode should be dropped.
+  Dropped opcodes behave as if they had finished instantly, so e.g. dialogue never creates a window, preprocesses its string or waits for input.
+  Otherwise, durations and speeds are scaled by the speedup multiplier, the same way GetMovementSpeedParam and GetWaitTime do for the opcodes they're hooked into.
+*/
+__attribute((used)) bool ApplyOpcodeSpeedup(uint16_t opcode_id, uint16_t* params) {
+  RestoreSpeedupParam(); // The previous opcode is done with its parameters
+  if(!CRASS_SETTINGS.speedup_active)
+    return false;
+  enum opcode_speedup_kind speedup_kind = GetOpcodeSpeedupKind(opcode_id);
+  if(IsWithinRange(speedup_kind, OPCODE_SPEEDUP_DURATION_1, OPCODE_SPEEDUP_DURATION_3)) {
+    uint16_t* duration = &(params[speedup_kind - OPCODE_SPEEDUP_DURATION_1]);
+    int scaled_duration = ScaleSpeedupDuration(ScriptParamToInt(*duration), CRASS_SPEEDUP_DURATION);
+    if(scaled_duration != ScriptParamToInt(*duration))
+      SetSpeedupParam(duration, scaled_duration);
+  }
+  else if(IsWithinRange(speedup_kind, OPCODE_SPEEDUP_SPEED_1, OPCODE_SPEEDUP_SPEED_3)) {
+    uint16_t* speed = &(params[speedup_kind - OPCODE_SPEEDUP_SPEED_1]);
+    int scaled_speed = ScaleSpeedupSpeed(ScriptParamToInt(*speed), CRASS_SPEEDUP_SPEED); // Non-positive speeds may have special meanings, so they're left be
+    if(scaled_speed != ScriptParamToInt(*speed))
+      SetSpeedupParam(speed, scaled_speed);
+  }
+  return speedup_kind == OPCODE_SPEEDUP_DROP;
+}
+
+/*
+  If a cutscene speedup is in progress, bump up the movement speed, up to CRASS_SPEEDUP_SPEED.
 */
 __attribute((used)) int16_t GetMovementSpeedParam(uint16_t parameter) {
+  int16_t speed = ScriptParamToFixedPoint16(parameter);
   if(CRASS_SETTINGS.speedup_active)
-    parameter = 13;
-  return ScriptParamToFixedPoint16(parameter);
+    speed = ScaleSpeedupSpeed(speed, ScriptParamToFixedPoint16(CRASS_SPEEDUP_SPEED));
+  return speed;
 }
 
 /*
-  If a cutscene speedup is in progress, bump up the turn speed to 1.
+  If a cutscene speedup is in progress, bump up the turn speed, up to 1 (lower is faster).
+  The original turn speed is restored once the opcode has run, see SetSpeedupParam.
 */
 __attribute((used)) void TrySpeedUpTurnSpeedParam(uint16_t* opcode_id_addr) {
-  if(CRASS_SETTINGS.speedup_active && *opcode_id_addr != OPCODE_TURN_DIRECTION)
-    opcode_id_addr[1] = 1;
+  if(CRASS_SETTINGS.speedup_active && *opcode_id_addr != OPCODE_TURN_DIRECTION) {
+    int scaled_speed = ScaleSpeedupDuration(ScriptParamToInt(opcode_id_addr[1]), 1);
+    if(scaled_speed != ScriptParamToInt(opcode_id_addr[1]))
+      SetSpeedupParam(&(opcode_id_addr[1]), scaled_speed);
+  }
 }
 
 /*
-  If a cutscene speedup is in progress, bump down the wait time to 1.
+  If a cutscene speedup is in progress, bump down the wait time, down to CRASS_SPEEDUP_DURATION.
 */
-__attribute((used)) int16_t GetWaitTime(uint16_t wait_param) { return CRASS_SETTINGS.speedup_active ? 1 : ScriptParamToInt(wait_param); }
+__attribute((used)) int16_t GetWaitTime(uint16_t wait_param) {
+  int16_t wait_time = ScriptParamToInt(wait_param);
+  return CRASS_SETTINGS.speedup_active ? ScaleSpeedupDuration(wait_time, CRASS_SPEEDUP_DURATION) : wait_time;
+}
 
 /*
   If a cutscene speedup is in progress, make any dialogue boxes created by a script opcode have an invisible window.
@@ -506,6 +1072,22 @@ __attribute((naked)) void CheckSelectPressTrampoline(void) {
   asm("b CancelRecoverStart");
 }
 
+__attribute((naked)) void SpeedupOpcodeCheck(void) {
+  asm("push {r0-r3,r12,lr}");
+  asm("mov r0,r5"); // Opcode ID
+  asm("mov r1,r6"); // Parameter list
+  asm("bl ApplyOpcodeSpeedup");
+  asm("cmp r0,#0x0");
+  asm("pop {r0-r3,r12,lr}");
+  asm("bne ScriptEngineReturnTwo");
+  #if CUSTOM_GROUND_INSTRUCTIONS
+  asm("b HookOpcodeCheck");
+  #else
+  asm("cmp r5,r0");
+  asm("b OpcodeCheck+4");
+  #endif
+}
+
 __attribute((naked)) int TrySpeedUpTurnSpeedParamTrampoline(void) {
   asm("mov r0,r6");
   asm("bl TrySpeedUpTurnSpeedParam");
@@ -23,6 +23,109 @@ enum opcode_parse_kind {
   OPCODE_PARSE_CALL_COMMON = 7
 };
 
+// How an opcode is treated while a cutscene is sped up, see
+// "crass_opcode_speedup.yml".
+enum opcode_speedup_kind {
+  OPCODE_SPEEDUP_RUN = 0,  // The opcode runs as usual.
+  OPCODE_SPEEDUP_DROP = 1, // The opcode doesn't run at all.
+  OPCODE_SPEEDUP_DURATION_1 = 2, // The first, second or third parameter is a
+  OPCODE_SPEEDUP_DURATION_2 = 3, // duration in frames, and is clamped down to
+  OPCODE_SPEEDUP_DURATION_3 = 4, // CRASS_SPEEDUP_DURATION.
+  OPCODE_SPEEDUP_SPEED_1 = 5, // The first, second or third parameter is a
+  OPCODE_SPEEDUP_SPEED_2 = 6, // speed, and is clamped up to
+  OPCODE_SPEEDUP_SPEED_3 = 7  // CRASS_SPEEDUP_SPEED.
+};
+
+// The longest duration in frames and the slowest speed script opcodes are
+// allowed to use during a cutscene speedup at CRASS_SPEEDUP_MAX.
+#define CRASS_SPEEDUP_DURATION 1
+#define CRASS_SPEEDUP_SPEED 13
+
+// How much faster a cutscene plays during a speedup. Other multipliers scale
+// durations and speeds instead of replacing them, but never past the limits of
+// CRASS_SPEEDUP_MAX. Set with special process 254.
+enum crass_speedup_multiplier {
+  CRASS_SPEEDUP_MAX = 0, // Durations and speeds are replaced with
+                         // CRASS_SPEEDUP_DURATION and CRASS_SPEEDUP_SPEED.
+  CRASS_SPEEDUP_2X = 1,
+  CRASS_SPEEDUP_4X = 2,
+  CRASS_SPEEDUP_8X = 3   // Values are the base 2 logarithm of the multiplier.
+};
+
+// If this script variable is set to a non-zero value, every cutscene is
+// skipped or sped up without pressing Select. -1 to only allow enabling
+// auto-skip with special process 253.
+#define CRASS_AUTO_SKIP_VARIABLE -1
+
+// The possible results of scanning a region of opcodes during a cutscene skip.
+// Results are remembered per address for the duration of a single skip attempt.
+enum crass_scan_outcome {
+  CRASS_SCAN_UNKNOWN = 0,        // The region has not been scanned yet.
+  CRASS_SCAN_IN_PROGRESS = 1,    // The scan hasn't finished yet.
+  CRASS_SCAN_TERMINATES = 2,     // The region reaches OPCODE_END or OPCODE_HOLD.
+  CRASS_SCAN_LOOPS = 3,          // The region never leaves a switch menu loop.
+  CRASS_SCAN_OUT_OF_BOUNDS = 4,  // The region reads opcodes outside the script.
+  CRASS_SCAN_TOO_DEEP = 5,       // The region nests more switch menus than
+                                 // CRASS_SCAN_MAX_DEPTH.
+  CRASS_SCAN_OVER_BUDGET = 6     // The scan took more than
+                                 // CRASS_SCAN_MAX_STEPS steps.
+};
+
+// Number of addresses whose final scan outcome can be remembered during a
+// single cutscene skip. Must be a power of two. Infinite loops are detected
+// independently of this table, so if it fills up, the only cost is that
+// further regions that failed may be scanned again when reached again.
+#define CRASS_SCAN_MEMO_CAPACITY 64
+
+// Maximum number of opcodes scanned per frame during a cutscene skip. Scenes
+// with more remaining opcodes are scanned over several frames while the main
+// routine waits.
+#define CRASS_SCAN_OPCODES_PER_FRAME 128
+
+// Maximum number of switch menus whose cases can be investigated at once
+// during a cutscene skip.
+#define CRASS_SCAN_MAX_DEPTH 16
+
+// Maximum number of steps a single cutscene skip scan may take. A step is an
+// opcode that is run, or a case (or the opcodes after the cases) of a switch
+// menu that the scan moves on to. Opcodes skipped over on a straight path
+// aren't counted, since they can't loop and already end at the end of the
+// script. This bounds scans of loops driven by script variables, which the
+// infinite loop detection can't catch. A scan that goes over budget redirects
+// to ROUTINE_MAP_TEST like any other failed scan.
+#define CRASS_SCAN_MAX_STEPS 4096
+
+// How the cutscene skip scanner treats an OPCODE_MESSAGE_MENU or
+// OPCODE_CALL_COMMON, looked up by menu ID or common routine ID in
+// src/crass_policies.c.
+enum crass_skip_policy {
+  CRASS_POLICY_DEFAULT = 0,   // Menus are skipped, common routines executed.
+  CRASS_POLICY_SKIP = 1,      // Step over the opcode without running it.
+  CRASS_POLICY_EXECUTE = 2,   // Run the opcode during the scan.
+  CRASS_POLICY_SIMULATE = 3,  // Step over the opcode and call its `simulate`
+                              // function to apply its effects instead.
+  CRASS_POLICY_REDIRECT = 4   // Step over the opcode, then redirect to
+                              // ROUTINE_MAP_TEST after the skip.
+};
+
+struct crass_menu_policy {
+  uint8_t kind; // See the enum "crass_skip_policy"
+  // For CRASS_POLICY_SIMULATE, called with the menu ID
+  void (*simulate)(int menu_id);
+};
+
+// Counters and high-water marks of the skip scanner, kept across skips to
+// help tune CRASS_SCAN_MAX_DEPTH, CRASS_SCAN_MEMO_CAPACITY and
+// CRASS_SCAN_MAX_STEPS.
+struct crass_scan_stats {
+  uint16_t max_depth;        // Most switch menus investigated at once.
+  uint16_t max_memo_entries; // Most scan outcomes remembered at once.
+  uint32_t last_executed_opcodes; // Opcodes run by the last scan.
+  uint32_t last_skipped_opcodes;  // Opcodes skipped over by the last scan.
+  uint32_t max_steps;             // Most steps taken by a single scan.
+  uint32_t over_budget_count;     // Scans that exceeded CRASS_SCAN_MAX_STEPS.
+};
+
 enum crass_kind {
   CRASS_DEFAULT =
       0, // The cutscene skip will perform its default settings: Attempting to
@@ -40,6 +143,50 @@ enum crass_kind {
           // ROUTINE_MAP_TEST.
 };
 
+// A small summary of the scene being played, computed once when the scene starts so a cutscene skip doesn't have to rescan the whole script.
+struct crass_scene_plan {
+  bool has_exit_opcode; // The scene contains OPCODE_MAIN_ENTER_DUNGEON or
+                        // OPCODE_MAIN_ENTER_GROUND somewhere. Only looked for
+                        // if `end_after_cutscene` is set.
+  bool unskippable;     // The scene is known to be unskippable and will be sped
+                        // up instead, see AnalyzeScenePlan.
+};
+
+// An Acting scene found to contain OPCODE_MAIN_ENTER_DUNGEON or
+// OPCODE_MAIN_ENTER_GROUND by scripts/crass_skip_table.py when running
+// `make patch`. Scenes without one aren't listed, since that's what the
+// on-device search finds by default.
+struct crass_skip_table_entry {
+  uint32_t scene_hash;       // HashSceneName of the scene's name. Entries are
+                             // sorted by this field.
+  uint16_t opcode_length;    // Size of the scene's opcodes in words, used to
+                             // detect scripts edited after the table was built.
+};
+
+// Maximum number of scenes in the precomputed skip table (8 bytes each). Only
+// scenes with an exit opcode are listed, which are a small share of all scenes.
+// If more don't fit, the rest are searched on the device when they start, so
+// the capacity only trades overlay space for a shorter scene start.
+#define CRASS_SKIP_TABLE_CAPACITY 256
+
+struct crass_skip_table {
+  uint32_t length;
+  struct crass_skip_table_entry entries[CRASS_SKIP_TABLE_CAPACITY];
+};
+
+// The cached result of IsMainRoutineInvalidToSkip, along with the fields of the
+// main routine it was computed from.
+struct crass_routine_eligibility {
+  bool valid;   // The cache holds a result.
+  bool invalid; // The result of IsMainRoutineInvalidToSkip.
+  bool in_call; // Whether ssb_info[1] held a return address.
+  int status;   // field_0x4 of the main routine.
+  uint16_t routine_kind;          // routine_kind of the main routine.
+  struct script_routine* routine; // The main routine itself.
+  void* file;      // ssb_info[0].file of the main routine.
+  void* call_file; // ssb_info[1].file of the main routine.
+};
+
 struct crass_settings {
   struct ssb_runtime_info
       return_info; // Used to return control flow back to either the next opcode
@@ -73,8 +220,29 @@ struct crass_settings {
                  // overworld.
   bool coroutine_hijack; // Indicates that a new coroutine will be loaded due to
                          // a cutscene skip.
+  uint8_t speedup_multiplier; // See the enum "crass_speedup_multiplier". Kept
+                              // when the other settings are reset.
+  bool auto_skip; // Every cutscene is skipped or sped up without pressing
+                  // Select, see IsAutoSkipEnabled. Kept when the other
+                  // settings are reset.
+  bool speedup_boost; // Select is held down, so the speedup temporarily runs at
+                      // CRASS_SPEEDUP_MAX.
+  struct crass_routine_eligibility eligibility; // See
+                                                // IsMainRoutineInvalidToSkipCached.
+  bool plan_pending; // The scene plan still has to be computed once the scene
+                     // starts playing.
+  uint32_t scene_hash; // HashSceneName of the current scene, used to look up
+                       // its plan in CRASS_SKIP_TABLE.
+  struct crass_scene_plan plan; // Summary of the current scene, only valid once
+                                // plan_pending is false.
 };
 
 extern struct crass_settings CRASS_SETTINGS;
+extern struct crass_skip_table CRASS_SKIP_TABLE;
+extern struct crass_scan_stats CRASS_SCAN_STATS;
+extern const struct crass_menu_policy CRASS_MESSAGE_MENU_POLICIES[];
+extern const int CRASS_MESSAGE_MENU_POLICY_AMOUNT;
+extern const uint8_t CRASS_COMMON_ROUTINE_POLICIES[];
+extern const int CRASS_COMMON_ROUTINE_POLICY_AMOUNT;
 
 #endif
@@ -0,0 +1,43 @@
+#include <pmdsky.h>
+#include <cot.h>
+#include "crass.h"
+
+// How a cutscene skip treats each OPCODE_MESSAGE_MENU and OPCODE_CALL_COMMON.
+// Both tables are indexed directly by ID; IDs past the end of a table, or
+// left out of it, use CRASS_POLICY_DEFAULT.
+
+#if CANCEL_RECOVER_ACTING_SKIP_SYSTEM
+
+// Gives the item the menu would have shown, like the menu does once closed.
+void SimulateItemGiftMenu(int menu_id) {
+  undefined4 unknown;
+  struct bulk_item item;
+  ItemAtTableIdx(0, &item);
+  ScriptSpecialProcessCall(&unknown, menu_id == 63 ? SPECIAL_PROC_ADD_ITEM_TO_BAG : SPECIAL_PROC_ADD_ITEM_TO_STORAGE, item.id.val, item.quantity);
+}
+
+const struct crass_menu_policy CRASS_MESSAGE_MENU_POLICIES[] = {
+  // MENU_HERO_NAME
+  [1] = { .kind = CRASS_POLICY_REDIRECT },
+  // MENU_TEAM_NAME
+  [4] = { .kind = CRASS_POLICY_REDIRECT },
+  // MENU_SAVE_MENU
+  [11] = { .kind = CRASS_POLICY_REDIRECT },
+  // MENU_DUNGEON_INITIALIZE_TEAM
+  [54] = { .kind = CRASS_POLICY_EXECUTE },
+  // Item-giving menus, to the bag and to storage
+  [63] = { .kind = CRASS_POLICY_SIMULATE, .simulate = SimulateItemGiftMenu },
+  [64] = { .kind = CRASS_POLICY_SIMULATE, .simulate = SimulateItemGiftMenu },
+};
+
+const int CRASS_MESSAGE_MENU_POLICY_AMOUNT = ARRAY_LENGTH(CRASS_MESSAGE_MENU_POLICIES);
+
+// Common routines can't be simulated or redirected; use CRASS_POLICY_SKIP or
+// CRASS_POLICY_EXECUTE.
+const uint8_t CRASS_COMMON_ROUTINE_POLICIES[] = {
+  [ROUTINE_HANYOU_SAVE_FUNC] = CRASS_POLICY_SKIP,
+};
+
+const int CRASS_COMMON_ROUTINE_POLICY_AMOUNT = ARRAY_LENGTH(CRASS_COMMON_ROUTINE_POLICIES);
+
+#endif
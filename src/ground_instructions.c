@@ -53,6 +53,8 @@ void OpCheckInputStatus(struct script_routine* routine, uint16_t* args) {
 // `handler` is a pointer to your handler function (see the examples above).
 // `n_params` must match the number of parameters used in your handler function
 // (must be 0 or a positive number, instructions with variadic arguments are not supported).
+// `skip_kind` decides whether the instruction is run when a cutscene containing it is skipped
+// (see `enum custom_instruction_skip_kind`). It defaults to skipping over the instruction.
 // Custom instructions use ID 0x1000 + <array index>.
 //
 // Refer to README.md for instructions on how to access custom instructions in SkyTemple!
@@ -61,13 +63,15 @@ struct custom_instruction CUSTOM_INSTRUCTIONS[] = {
     {
         .name = "SetDialogueBoxAttributes",
         .handler = OpSetDialogueBoxAttributes,
-        .n_params = 6
+        .n_params = 6,
+        .skip_kind = CUSTOM_INSTRUCTION_SKIP_STEP_OVER
     },
     // ID 0x1001
     {
         .name = "CheckInputStatus",
         .handler = OpCheckInputStatus,
-        .n_params = 1
+        .n_params = 1,
+        .skip_kind = CUSTOM_INSTRUCTION_SKIP_EXECUTE
     }
 };
 
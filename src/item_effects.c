@@ -1,8 +1,11 @@
 #include <pmdsky.h>
 #include <cot.h>
 
+// Add your custom item effects below, then list them in src/custom_effects.yml.
+// An item effect should return true if a custom effect was applied.
+
 // Elixir: Refills 10 PP of each move
-/*static void ItemElixir(struct entity* target) {
+/*bool ItemElixir(struct entity* user, struct entity* target, struct item* item, bool is_thrown) {
   if (target->type == ENTITY_MONSTER) {
     struct monster* target_monster = (struct monster*) target->info;
     for (int i = 0; i < 4; i++) {
@@ -15,19 +18,6 @@
       current_move->pp = new_pp;
     }
   }
+  // Return true to signal that we've handled the effect
+  return true;
 }*/
-
-// Called when using items. Should return true if a custom effect was applied.
-bool CustomApplyItemEffect(
-  struct entity* user, struct entity* target, struct item* item, bool is_thrown
-) {
-  switch (item->id.val) {
-    /*case ITEM_MAX_ELIXIR:
-      // Replace item 99 (Max Elixir) with custom Elixir effect
-      ItemElixir(target);
-      // Return true to signal that we've handled the effect
-      return true;*/
-    default:
-      return false;
-  }
-}
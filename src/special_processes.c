@@ -4,13 +4,22 @@
 
 // Special process 100: Change border color
 // Based on https://github.com/SkyTemple/eos-move-effects/blob/master/example/process/set_frame_color.asm
-/*static int SpChangeBorderColor(short arg1) {
+/*static int SpChangeBorderColor(short arg1, short arg2) {
   SetBothScreensWindowsColor(arg1);
   return 0;
 }*/
 
+// Special process 252: Print how many cycles each profiled hook took so far, and start over if arg1 is non-zero.
+// Only does anything if COT_PROFILE is enabled in "include/cot/profile.h".
+static int SpDumpProfile(short reset, short arg2) {
+    #if COT_PROFILE && !defined(NDEBUG)
+    CotDumpProfile(reset != 0);
+    #endif
+    return 0;
+}
+
 // Special process 255: Return either the current cutscene_skip_settings::crass_kind value or the ID of the OPCODE_MESSAGE_MENU that was skipped.
-static int SpGetCrassKind() {
+static int SpGetCrassKind(short arg1, short arg2) {
     #if CANCEL_RECOVER_ACTING_SKIP_SYSTEM
     return CRASS_SETTINGS.menu_skipped > 0 ? CRASS_SETTINGS.menu_skipped : CRASS_SETTINGS.crass_kind;
     #else
@@ -18,19 +27,81 @@ static int SpGetCrassKind() {
     #endif
 }
 
+// Special process 253: Enable auto-skip if arg1 is non-zero, or disable it otherwise, and return whether it was enabled before.
+// While auto-skip is enabled, every cutscene is skipped (or sped up, if it can't be skipped) without pressing Select.
+static int SpSetCrassAutoSkip(short enabled, short arg2) {
+    #if CANCEL_RECOVER_ACTING_SKIP_SYSTEM
+    int was_enabled = CRASS_SETTINGS.auto_skip;
+    CRASS_SETTINGS.auto_skip = enabled != 0;
+    return was_enabled;
+    #else
+    return 0;
+    #endif
+}
+
+// Special process 254: Set the cutscene speedup multiplier to arg1 (see the enum "crass_speedup_multiplier" in "crass.h") and return the previous one.
+// The multiplier is kept across cutscenes, and invalid multipliers leave it unchanged.
+static int SpSetCrassSpeedupMultiplier(short multiplier, short arg2) {
+    #if CANCEL_RECOVER_ACTING_SKIP_SYSTEM
+    int previous_multiplier = CRASS_SETTINGS.speedup_multiplier;
+    if(IsWithinRange(multiplier, CRASS_SPEEDUP_MAX, CRASS_SPEEDUP_8X))
+      CRASS_SETTINGS.speedup_multiplier = multiplier;
+    return previous_multiplier;
+    #else
+    return 0;
+    #endif
+}
+
+// Add your custom special processes to the list below.
+// `id` is the special process ID used by `ProcessSpecial` in scripts, which must be 100 or greater
+// (see FIRST_CUSTOM_SPECIAL_PROCESS and CUSTOM_SPECIAL_PROCESS_ID_LIMIT in `include/cot/special_processes.h`).
+// `handler` is called with both arguments of `ProcessSpecial`, and its return value is passed back to the script.
+// `skip_kind` decides whether the special process is run when a cutscene containing it is skipped
+// (see `enum custom_special_process_skip_kind`). It defaults to running the special process.
+struct custom_special_process CUSTOM_SPECIAL_PROCESSES[] = {
+  /*{
+    .id = 100,
+    .name = "ChangeBorderColor",
+    .handler = SpChangeBorderColor,
+    .skip_kind = CUSTOM_SPECIAL_PROCESS_SKIP_STEP_OVER
+  },*/
+  {
+    .id = 252,
+    .name = "DumpProfile",
+    .handler = SpDumpProfile,
+    .skip_kind = CUSTOM_SPECIAL_PROCESS_SKIP_STEP_OVER
+  },
+  {
+    .id = 253,
+    .name = "SetCrassAutoSkip",
+    .handler = SpSetCrassAutoSkip,
+    .skip_kind = CUSTOM_SPECIAL_PROCESS_SKIP_EXECUTE
+  },
+  {
+    .id = 254,
+    .name = "SetCrassSpeedupMultiplier",
+    .handler = SpSetCrassSpeedupMultiplier,
+    .skip_kind = CUSTOM_SPECIAL_PROCESS_SKIP_EXECUTE
+  },
+  {
+    .id = 255,
+    .name = "GetCrassKind",
+    .handler = SpGetCrassKind,
+    .skip_kind = CUSTOM_SPECIAL_PROCESS_SKIP_EXECUTE
+  }
+};
+
+const int CUSTOM_SPECIAL_PROCESS_AMOUNT = ARRAY_LENGTH(CUSTOM_SPECIAL_PROCESSES);
+
 // Called for special process IDs 100 and greater.
 //
 // Set return_val to the return value that should be passed back to the game's script engine. Return true,
-// if the special process was handled.
+// if the special process was handled. Special processes in CUSTOM_SPECIAL_PROCESSES are handled here,
+// but you can also handle other IDs yourself.
 bool CustomScriptSpecialProcessCall(undefined4* unknown, uint32_t special_process_id, short arg1, short arg2, int* return_val) {
-  switch (special_process_id) {
-    /*case 100:
-      *return_val = SpChangeBorderColor(arg1);
-      return true;*/
-    case 255:
-        *return_val = SpGetCrassKind();
-        return true;
-    default:
-      return false;
-  }
+  struct custom_special_process* special_process = GetCustomSpecialProcess(special_process_id);
+  if (special_process == NULL)
+    return false;
+  *return_val = special_process->handler(arg1, arg2);
+  return true;
 }